@@ -0,0 +1,1084 @@
+/**
+ * @file aes.cc
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief The key schedule, the three ways to run the rounds, and the tests.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+
+#include "aes.hh"
+#include "cpu-features.hh"
+#include "entropy.hh"
+#include "test-utils.hh"
+
+#if defined( __x86_64__ )
+#    include <immintrin.h>
+#endif
+
+#include <cstring>
+#include <vector>
+
+namespace aes = markbench::aes;
+
+namespace
+{
+    // the tables are worked out by the compiler, from the field itself.
+
+    constexpr std::uint8_t times_x ( std::uint8_t const a )
+    {
+        return std::uint8_t ( ( a << 1 ) ^ ( a & 0x80 ? 0x1b : 0 ) );
+    }
+
+    constexpr std::uint8_t multiply ( std::uint8_t a, std::uint8_t b )
+    {
+        std::uint8_t result = 0;
+        for ( ; b; b >>= 1, a = times_x ( a ) )
+        {
+            if ( b & 1 )
+            {
+                result ^= a;
+            }
+        }
+        return result;
+    }
+
+    // a^254, which is a's inverse, and 0 for 0.
+    constexpr std::uint8_t inverse ( std::uint8_t const a )
+    {
+        std::uint8_t result = 1;
+        std::uint8_t power  = a;
+        for ( unsigned exponent = 254; exponent; exponent >>= 1 )
+        {
+            if ( exponent & 1 )
+            {
+                result = multiply ( result, power );
+            }
+            power = multiply ( power, power );
+        }
+        return result;
+    }
+
+    constexpr std::uint8_t rotate ( std::uint8_t const a, unsigned const n )
+    {
+        return std::uint8_t ( ( a << n ) | ( a >> ( 8 - n ) ) );
+    }
+
+    constexpr std::uint32_t rotate ( std::uint32_t const w, unsigned const n )
+    {
+        return ( w >> n ) | ( w << ( 32 - n ) );
+    }
+
+    constexpr std::array< std::uint8_t, 256 > make_sbox ( )
+    {
+        std::array< std::uint8_t, 256 > result { };
+        for ( unsigned x = 0; x < 256; x++ )
+        {
+            std::uint8_t const b = inverse ( std::uint8_t ( x ) );
+            result [ x ] = b ^ rotate ( b, 1 ) ^ rotate ( b, 2 )
+                         ^ rotate ( b, 3 ) ^ rotate ( b, 4 ) ^ 0x63;
+        }
+        return result;
+    }
+
+    constexpr std::array< std::uint8_t, 256 > sbox = make_sbox ( );
+
+    constexpr std::array< std::uint8_t, 256 > make_inverse_sbox ( )
+    {
+        std::array< std::uint8_t, 256 > result { };
+        for ( unsigned x = 0; x < 256; x++ ) { result [ sbox [ x ] ] = x; }
+        return result;
+    }
+
+    constexpr std::array< std::uint8_t, 256 > inverse_sbox =
+            make_inverse_sbox ( );
+
+    constexpr std::uint32_t column ( std::uint8_t const a,
+                                     std::uint8_t const b,
+                                     std::uint8_t const c,
+                                     std::uint8_t const d )
+    {
+        return std::uint32_t ( a ) << 24 | std::uint32_t ( b ) << 16
+             | std::uint32_t ( c ) << 8 | d;
+    }
+
+    using table = std::array< std::array< std::uint32_t, 256 >, 4 >;
+
+    // SubBytes and MixColumns of one byte, and its three rotations.
+    constexpr table make_encryption_table ( )
+    {
+        table result { };
+        for ( unsigned x = 0; x < 256; x++ )
+        {
+            std::uint8_t const s = sbox [ x ];
+            result [ 0 ][ x ] =
+                    column ( multiply ( s, 2 ), s, s, multiply ( s, 3 ) );
+            for ( unsigned t = 1; t < 4; t++ )
+            {
+                result [ t ][ x ] = rotate ( result [ 0 ][ x ], 8 * t );
+            }
+        }
+        return result;
+    }
+
+    // InvSubBytes and InvMixColumns of one byte, and its three rotations.
+    constexpr table make_decryption_table ( )
+    {
+        table result { };
+        for ( unsigned x = 0; x < 256; x++ )
+        {
+            std::uint8_t const s = inverse_sbox [ x ];
+            result [ 0 ][ x ]    = column ( multiply ( s, 0x0e ),
+                                         multiply ( s, 0x09 ),
+                                         multiply ( s, 0x0d ),
+                                         multiply ( s, 0x0b ) );
+            for ( unsigned t = 1; t < 4; t++ )
+            {
+                result [ t ][ x ] = rotate ( result [ 0 ][ x ], 8 * t );
+            }
+        }
+        return result;
+    }
+
+    constexpr table te = make_encryption_table ( );
+    constexpr table td = make_decryption_table ( );
+
+    constexpr std::uint8_t byte ( std::uint32_t const w, unsigned const n )
+    {
+        return std::uint8_t ( w >> ( 24 - 8 * n ) );
+    }
+
+    inline std::uint32_t load_word ( std::uint8_t const *from )
+    {
+        return column ( from [ 0 ], from [ 1 ], from [ 2 ], from [ 3 ] );
+    }
+
+    inline void store_word ( std::uint8_t *to, std::uint32_t const w )
+    {
+        for ( unsigned n = 0; n < 4; n++ ) { to [ n ] = byte ( w, n ); }
+    }
+
+    std::uint32_t sub_word ( std::uint32_t const w )
+    {
+        return column ( sbox [ byte ( w, 0 ) ],
+                        sbox [ byte ( w, 1 ) ],
+                        sbox [ byte ( w, 2 ) ],
+                        sbox [ byte ( w, 3 ) ] );
+    }
+
+    // the table path.
+    namespace portable
+    {
+        using schedule = std::array< std::uint32_t, 4 * ( aes::rounds + 1 ) >;
+
+        // one round's column: four lookups, one for each byte, each from
+        // the column ShiftRows moves it from.
+        inline std::uint32_t round_column ( table const        &t,
+                                            std::uint32_t const a,
+                                            std::uint32_t const b,
+                                            std::uint32_t const c,
+                                            std::uint32_t const d,
+                                            std::uint32_t const k )
+        {
+            return t [ 0 ][ byte ( a, 0 ) ] ^ t [ 1 ][ byte ( b, 1 ) ]
+                 ^ t [ 2 ][ byte ( c, 2 ) ] ^ t [ 3 ][ byte ( d, 3 ) ] ^ k;
+        }
+
+        // the last round's column, which has no MixColumns.
+        inline std::uint32_t
+                last_column ( std::array< std::uint8_t, 256 > const &s,
+                              std::uint32_t const                    a,
+                              std::uint32_t const                    b,
+                              std::uint32_t const                    c,
+                              std::uint32_t const                    d,
+                              std::uint32_t const                    k )
+        {
+            return column ( s [ byte ( a, 0 ) ],
+                            s [ byte ( b, 1 ) ],
+                            s [ byte ( c, 2 ) ],
+                            s [ byte ( d, 3 ) ] )
+                 ^ k;
+        }
+
+        void encrypt ( schedule const      &k,
+                       std::uint8_t const *in,
+                       std::uint8_t       *out )
+        {
+            std::uint32_t s0 = load_word ( in ) ^ k [ 0 ];
+            std::uint32_t s1 = load_word ( in + 4 ) ^ k [ 1 ];
+            std::uint32_t s2 = load_word ( in + 8 ) ^ k [ 2 ];
+            std::uint32_t s3 = load_word ( in + 12 ) ^ k [ 3 ];
+            for ( std::size_t r = 1; r < aes::rounds; r++ )
+            {
+                std::uint32_t const *const key = &k [ 4 * r ];
+                std::uint32_t const t0 =
+                        round_column ( te, s0, s1, s2, s3, key [ 0 ] );
+                std::uint32_t const t1 =
+                        round_column ( te, s1, s2, s3, s0, key [ 1 ] );
+                std::uint32_t const t2 =
+                        round_column ( te, s2, s3, s0, s1, key [ 2 ] );
+                std::uint32_t const t3 =
+                        round_column ( te, s3, s0, s1, s2, key [ 3 ] );
+                s0 = t0;
+                s1 = t1;
+                s2 = t2;
+                s3 = t3;
+            }
+            std::uint32_t const *const key = &k [ 4 * aes::rounds ];
+            store_word ( out, last_column ( sbox, s0, s1, s2, s3, key [ 0 ] ) );
+            store_word ( out + 4,
+                         last_column ( sbox, s1, s2, s3, s0, key [ 1 ] ) );
+            store_word ( out + 8,
+                         last_column ( sbox, s2, s3, s0, s1, key [ 2 ] ) );
+            store_word ( out + 12,
+                         last_column ( sbox, s3, s0, s1, s2, key [ 3 ] ) );
+        }
+
+        // the equivalent inverse cipher, so the rounds look up tables too.
+        // InvShiftRows takes the bytes from the other way around.
+        void decrypt ( schedule const      &k,
+                       std::uint8_t const *in,
+                       std::uint8_t       *out )
+        {
+            std::uint32_t s0 = load_word ( in ) ^ k [ 0 ];
+            std::uint32_t s1 = load_word ( in + 4 ) ^ k [ 1 ];
+            std::uint32_t s2 = load_word ( in + 8 ) ^ k [ 2 ];
+            std::uint32_t s3 = load_word ( in + 12 ) ^ k [ 3 ];
+            for ( std::size_t r = 1; r < aes::rounds; r++ )
+            {
+                std::uint32_t const *const key = &k [ 4 * r ];
+                std::uint32_t const t0 =
+                        round_column ( td, s0, s3, s2, s1, key [ 0 ] );
+                std::uint32_t const t1 =
+                        round_column ( td, s1, s0, s3, s2, key [ 1 ] );
+                std::uint32_t const t2 =
+                        round_column ( td, s2, s1, s0, s3, key [ 2 ] );
+                std::uint32_t const t3 =
+                        round_column ( td, s3, s2, s1, s0, key [ 3 ] );
+                s0 = t0;
+                s1 = t1;
+                s2 = t2;
+                s3 = t3;
+            }
+            std::uint32_t const *const key = &k [ 4 * aes::rounds ];
+            auto const &is = inverse_sbox;
+            store_word ( out, last_column ( is, s0, s3, s2, s1, key [ 0 ] ) );
+            store_word ( out + 4,
+                         last_column ( is, s1, s0, s3, s2, key [ 1 ] ) );
+            store_word ( out + 8,
+                         last_column ( is, s2, s1, s0, s3, key [ 2 ] ) );
+            store_word ( out + 12,
+                         last_column ( is, s3, s2, s1, s0, key [ 3 ] ) );
+        }
+
+        // adds one to the last 64 bits, big-endian.
+        void increment ( aes::block &counter )
+        {
+            for ( std::size_t i = aes::block_bytes; i-- > 8; )
+            {
+                if ( ++counter [ i ] != 0 )
+                {
+                    break;
+                }
+            }
+        }
+
+        void ctr ( schedule const      &k,
+                   aes::block           counter,
+                   std::uint8_t const *in,
+                   std::uint8_t       *out,
+                   std::size_t const   bytes )
+        {
+            aes::block stream;
+            for ( std::size_t i = 0; i < bytes; i += aes::block_bytes )
+            {
+                encrypt ( k, counter.data ( ), stream.data ( ) );
+                increment ( counter );
+                std::size_t const part =
+                        std::min ( bytes - i, aes::block_bytes );
+                for ( std::size_t j = 0; j < part; j++ )
+                {
+                    out [ i + j ] = in [ i + j ] ^ stream [ j ];
+                }
+            }
+        }
+
+        void cbc_encrypt ( schedule const      &k,
+                           aes::block           chain,
+                           std::uint8_t const *in,
+                           std::uint8_t       *out,
+                           std::size_t const   bytes )
+        {
+            for ( std::size_t i = 0; i < bytes; i += aes::block_bytes )
+            {
+                for ( std::size_t j = 0; j < aes::block_bytes; j++ )
+                {
+                    chain [ j ] ^= in [ i + j ];
+                }
+                encrypt ( k, chain.data ( ), chain.data ( ) );
+                std::memcpy ( out + i, chain.data ( ), aes::block_bytes );
+            }
+        }
+
+        void cbc_decrypt ( schedule const      &k,
+                           aes::block           chain,
+                           std::uint8_t const *in,
+                           std::uint8_t       *out,
+                           std::size_t const   bytes )
+        {
+            aes::block cipher;
+            aes::block plain;
+            for ( std::size_t i = 0; i < bytes; i += aes::block_bytes )
+            {
+                std::memcpy ( cipher.data ( ), in + i, aes::block_bytes );
+                decrypt ( k, cipher.data ( ), plain.data ( ) );
+                for ( std::size_t j = 0; j < aes::block_bytes; j++ )
+                {
+                    out [ i + j ] = plain [ j ] ^ chain [ j ];
+                }
+                chain = cipher;
+            }
+        }
+    } // namespace portable
+} // namespace
+
+#if defined( __x86_64__ )
+#    pragma GCC push_options
+#    pragma GCC target( "aes,ssse3,sse4.1" )
+namespace
+{
+    // the AES-NI path. The round keys are from the portable schedule, whose
+    // bytes are in the order the instructions want them.
+    namespace aesni
+    {
+        // how many blocks are in flight, enough to cover the latency of
+        // aesenc on every processor that has it.
+        constexpr std::size_t lanes = 8;
+
+        inline __m128i load ( std::uint8_t const *from )
+        {
+            return _mm_loadu_si128 ( reinterpret_cast< __m128i const * > (
+                    from ) );
+        }
+
+        inline void store ( std::uint8_t *to, __m128i const value )
+        {
+            _mm_storeu_si128 ( reinterpret_cast< __m128i * > ( to ), value );
+        }
+
+        // reverses the bytes, which turns a big-endian counter into one
+        // _mm_add_epi64 can count with, and back.
+        inline __m128i swap ( __m128i const value )
+        {
+            return _mm_shuffle_epi8 (
+                    value,
+                    _mm_set_epi64x ( 0x0001020304050607, 0x08090a0b0c0d0e0f ) );
+        }
+
+        struct schedule
+        {
+            __m128i keys [ aes::rounds + 1 ];
+
+            explicit schedule ( std::uint8_t const *bytes )
+            {
+                for ( std::size_t r = 0; r <= aes::rounds; r++ )
+                {
+                    keys [ r ] = load ( bytes + aes::block_bytes * r );
+                }
+            }
+        };
+
+        inline __m128i encrypt ( schedule const &k, __m128i b )
+        {
+            b = _mm_xor_si128 ( b, k.keys [ 0 ] );
+            for ( std::size_t r = 1; r < aes::rounds; r++ )
+            {
+                b = _mm_aesenc_si128 ( b, k.keys [ r ] );
+            }
+            return _mm_aesenclast_si128 ( b, k.keys [ aes::rounds ] );
+        }
+
+        inline __m128i decrypt ( schedule const &k, __m128i b )
+        {
+            b = _mm_xor_si128 ( b, k.keys [ 0 ] );
+            for ( std::size_t r = 1; r < aes::rounds; r++ )
+            {
+                b = _mm_aesdec_si128 ( b, k.keys [ r ] );
+            }
+            return _mm_aesdeclast_si128 ( b, k.keys [ aes::rounds ] );
+        }
+
+        /**
+         * @brief CTR from the counter, which is byte-swapped and counted on
+         * past the blocks done. Also finishes what the VAES path leaves.
+         */
+        void ctr_from ( schedule const      &k,
+                        __m128i             &counter,
+                        std::uint8_t const *in,
+                        std::uint8_t       *out,
+                        std::size_t const   bytes )
+        {
+            __m128i const one = _mm_set_epi64x ( 0, 1 );
+            std::size_t   i   = 0;
+            for ( ; i + lanes * aes::block_bytes <= bytes;
+                  i += lanes * aes::block_bytes )
+            {
+                __m128i b [ lanes ];
+#    pragma GCC unroll 8
+                for ( std::size_t j = 0; j < lanes; j++ )
+                {
+                    b [ j ]  = _mm_xor_si128 ( swap ( counter ), k.keys [ 0 ] );
+                    counter = _mm_add_epi64 ( counter, one );
+                }
+                for ( std::size_t r = 1; r < aes::rounds; r++ )
+                {
+#    pragma GCC unroll 8
+                    for ( std::size_t j = 0; j < lanes; j++ )
+                    {
+                        b [ j ] = _mm_aesenc_si128 ( b [ j ], k.keys [ r ] );
+                    }
+                }
+#    pragma GCC unroll 8
+                for ( std::size_t j = 0; j < lanes; j++ )
+                {
+                    std::size_t const at = i + j * aes::block_bytes;
+                    b [ j ] = _mm_aesenclast_si128 ( b [ j ],
+                                                     k.keys [ aes::rounds ] );
+                    store ( out + at,
+                            _mm_xor_si128 ( load ( in + at ), b [ j ] ) );
+                }
+            }
+            for ( ; i < bytes; i += aes::block_bytes )
+            {
+                alignas ( 16 ) std::uint8_t stream [ aes::block_bytes ];
+                store ( stream, encrypt ( k, swap ( counter ) ) );
+                counter                = _mm_add_epi64 ( counter, one );
+                std::size_t const part =
+                        std::min ( bytes - i, aes::block_bytes );
+                for ( std::size_t j = 0; j < part; j++ )
+                {
+                    out [ i + j ] = in [ i + j ] ^ stream [ j ];
+                }
+            }
+        }
+
+        void ctr ( std::uint8_t const *keys,
+                   aes::block const   &counter,
+                   std::uint8_t const *in,
+                   std::uint8_t       *out,
+                   std::size_t const   bytes )
+        {
+            __m128i c = swap ( load ( counter.data ( ) ) );
+            ctr_from ( schedule { keys }, c, in, out, bytes );
+        }
+
+        void cbc_encrypt ( std::uint8_t const *keys,
+                           aes::block const   &iv,
+                           std::uint8_t const *in,
+                           std::uint8_t       *out,
+                           std::size_t const   bytes )
+        {
+            schedule const k { keys };
+            __m128i        chain = load ( iv.data ( ) );
+            for ( std::size_t i = 0; i < bytes; i += aes::block_bytes )
+            {
+                chain = encrypt ( k, _mm_xor_si128 ( chain, load ( in + i ) ) );
+                store ( out + i, chain );
+            }
+        }
+
+        /**
+         * @brief CBC decryption from the chain, the last ciphertext block
+         * before in. Also finishes what the VAES path leaves.
+         */
+        void cbc_decrypt_from ( schedule const      &k,
+                                __m128i              chain,
+                                std::uint8_t const *in,
+                                std::uint8_t       *out,
+                                std::size_t const   bytes )
+        {
+            std::size_t i = 0;
+            for ( ; i + lanes * aes::block_bytes <= bytes;
+                  i += lanes * aes::block_bytes )
+            {
+                __m128i c [ lanes ];
+                __m128i b [ lanes ];
+#    pragma GCC unroll 8
+                for ( std::size_t j = 0; j < lanes; j++ )
+                {
+                    c [ j ] = load ( in + i + j * aes::block_bytes );
+                    b [ j ] = _mm_xor_si128 ( c [ j ], k.keys [ 0 ] );
+                }
+                for ( std::size_t r = 1; r < aes::rounds; r++ )
+                {
+#    pragma GCC unroll 8
+                    for ( std::size_t j = 0; j < lanes; j++ )
+                    {
+                        b [ j ] = _mm_aesdec_si128 ( b [ j ], k.keys [ r ] );
+                    }
+                }
+#    pragma GCC unroll 8
+                for ( std::size_t j = 0; j < lanes; j++ )
+                {
+                    b [ j ] = _mm_aesdeclast_si128 ( b [ j ],
+                                                     k.keys [ aes::rounds ] );
+                    store ( out + i + j * aes::block_bytes,
+                            _mm_xor_si128 ( b [ j ], chain ) );
+                    chain = c [ j ];
+                }
+            }
+            for ( ; i < bytes; i += aes::block_bytes )
+            {
+                __m128i const c = load ( in + i );
+                store ( out + i, _mm_xor_si128 ( decrypt ( k, c ), chain ) );
+                chain = c;
+            }
+        }
+
+        void cbc_decrypt ( std::uint8_t const *keys,
+                           aes::block const   &iv,
+                           std::uint8_t const *in,
+                           std::uint8_t       *out,
+                           std::size_t const   bytes )
+        {
+            cbc_decrypt_from (
+                    schedule { keys }, load ( iv.data ( ) ), in, out, bytes );
+        }
+    } // namespace aesni
+} // namespace
+#    pragma GCC pop_options
+
+#    pragma GCC push_options
+#    pragma GCC target( "aes,ssse3,sse4.1,avx,avx2,vaes" )
+namespace
+{
+    // the VAES path: the AES-NI path, two blocks to a register.
+    namespace vaes
+    {
+        // registers in flight, of two blocks each.
+        constexpr std::size_t lanes = 8;
+        constexpr std::size_t step  = 2 * lanes * aes::block_bytes;
+
+        inline __m256i load ( std::uint8_t const *from )
+        {
+            return _mm256_loadu_si256 ( reinterpret_cast< __m256i const * > (
+                    from ) );
+        }
+
+        inline void store ( std::uint8_t *to, __m256i const value )
+        {
+            _mm256_storeu_si256 ( reinterpret_cast< __m256i * > ( to ),
+                                  value );
+        }
+
+        struct schedule
+        {
+            __m256i keys [ aes::rounds + 1 ];
+
+            explicit schedule ( aesni::schedule const &k )
+            {
+                for ( std::size_t r = 0; r <= aes::rounds; r++ )
+                {
+                    keys [ r ] = _mm256_broadcastsi128_si256 ( k.keys [ r ] );
+                }
+            }
+        };
+
+        void ctr ( std::uint8_t const *keys,
+                   aes::block const   &counter,
+                   std::uint8_t const *in,
+                   std::uint8_t       *out,
+                   std::size_t const   bytes )
+        {
+            aesni::schedule const narrow { keys };
+            schedule const        k { narrow };
+            __m128i c = aesni::swap ( aesni::load ( counter.data ( ) ) );
+            __m256i const reversal = _mm256_set_epi64x ( 0x0001020304050607,
+                                                         0x08090a0b0c0d0e0f,
+                                                         0x0001020304050607,
+                                                         0x08090a0b0c0d0e0f );
+            __m256i const two      = _mm256_set_epi64x ( 0, 2, 0, 2 );
+            // the counters of the next two blocks.
+            __m256i pair = _mm256_set_m128i (
+                    _mm_add_epi64 ( c, _mm_set_epi64x ( 0, 1 ) ), c );
+            std::size_t i = 0;
+            for ( ; i + step <= bytes; i += step )
+            {
+                __m256i b [ lanes ];
+#    pragma GCC unroll 8
+                for ( std::size_t j = 0; j < lanes; j++ )
+                {
+                    b [ j ] = _mm256_xor_si256 (
+                            _mm256_shuffle_epi8 ( pair, reversal ),
+                            k.keys [ 0 ] );
+                    pair = _mm256_add_epi64 ( pair, two );
+                }
+                for ( std::size_t r = 1; r < aes::rounds; r++ )
+                {
+#    pragma GCC unroll 8
+                    for ( std::size_t j = 0; j < lanes; j++ )
+                    {
+                        b [ j ] = _mm256_aesenc_epi128 ( b [ j ],
+                                                         k.keys [ r ] );
+                    }
+                }
+#    pragma GCC unroll 8
+                for ( std::size_t j = 0; j < lanes; j++ )
+                {
+                    std::size_t const at = i + 2 * j * aes::block_bytes;
+                    b [ j ] = _mm256_aesenclast_epi128 (
+                            b [ j ], k.keys [ aes::rounds ] );
+                    store ( out + at,
+                            _mm256_xor_si256 ( load ( in + at ), b [ j ] ) );
+                }
+            }
+            c = _mm256_castsi256_si128 ( pair );
+            aesni::ctr_from ( narrow, c, in + i, out + i, bytes - i );
+        }
+
+        void cbc_decrypt ( std::uint8_t const *keys,
+                           aes::block const   &iv,
+                           std::uint8_t const *in,
+                           std::uint8_t       *out,
+                           std::size_t const   bytes )
+        {
+            aesni::schedule const narrow { keys };
+            schedule const        k { narrow };
+            __m128i               chain = aesni::load ( iv.data ( ) );
+            std::size_t           i     = 0;
+            for ( ; i + step <= bytes; i += step )
+            {
+                __m256i c [ lanes ];
+                __m256i previous [ lanes ];
+                __m256i b [ lanes ];
+                // every block's ciphertext, and the one before it, which for
+                // the first is the chain.
+                previous [ 0 ] = _mm256_set_m128i ( aesni::load ( in + i ),
+                                                    chain );
+#    pragma GCC unroll 8
+                for ( std::size_t j = 0; j < lanes; j++ )
+                {
+                    std::size_t const at = i + 2 * j * aes::block_bytes;
+                    c [ j ]              = load ( in + at );
+                    if ( j > 0 )
+                    {
+                        previous [ j ] = load ( in + at - aes::block_bytes );
+                    }
+                    b [ j ] = _mm256_xor_si256 ( c [ j ], k.keys [ 0 ] );
+                }
+                chain = _mm256_extracti128_si256 ( c [ lanes - 1 ], 1 );
+                for ( std::size_t r = 1; r < aes::rounds; r++ )
+                {
+#    pragma GCC unroll 8
+                    for ( std::size_t j = 0; j < lanes; j++ )
+                    {
+                        b [ j ] = _mm256_aesdec_epi128 ( b [ j ],
+                                                         k.keys [ r ] );
+                    }
+                }
+#    pragma GCC unroll 8
+                for ( std::size_t j = 0; j < lanes; j++ )
+                {
+                    b [ j ] = _mm256_aesdeclast_epi128 (
+                            b [ j ], k.keys [ aes::rounds ] );
+                    store ( out + i + 2 * j * aes::block_bytes,
+                            _mm256_xor_si256 ( b [ j ], previous [ j ] ) );
+                }
+            }
+            aesni::cbc_decrypt_from (
+                    narrow, chain, in + i, out + i, bytes - i );
+        }
+    } // namespace vaes
+} // namespace
+#    pragma GCC pop_options
+#endif
+
+std::string aes::path_name ( path const p )
+{
+    switch ( p )
+    {
+        case path::table: return "table";
+        case path::aesni: return "aesni";
+        case path::vaes: return "vaes";
+        default: return "?";
+    }
+}
+
+aes::cipher::cipher ( path const p, key const &k ) : kind { p }
+{
+    // FIPS-197 section 5.2, for eight word keys.
+    constexpr std::size_t words = key_bytes / 4;
+    std::uint8_t          rcon  = 1;
+    for ( std::size_t i = 0; i < words; i++ )
+    {
+        encryption [ i ] = load_word ( k.data ( ) + 4 * i );
+    }
+    for ( std::size_t i = words; i < encryption.size ( ); i++ )
+    {
+        std::uint32_t temp = encryption [ i - 1 ];
+        if ( i % words == 0 )
+        {
+            temp = sub_word ( temp << 8 | temp >> 24 )
+                 ^ std::uint32_t ( rcon ) << 24;
+            rcon = times_x ( rcon );
+        } else if ( i % words == 4 )
+        {
+            temp = sub_word ( temp );
+        }
+        encryption [ i ] = encryption [ i - words ] ^ temp;
+    }
+    // section 5.3.5: the rounds backwards, with InvMixColumns on all but the
+    // first and last. td of a byte's S-box entry is InvMixColumns of the
+    // byte alone.
+    for ( std::size_t r = 0; r <= rounds; r++ )
+    {
+        for ( std::size_t i = 0; i < 4; i++ )
+        {
+            std::uint32_t const w = encryption [ 4 * ( rounds - r ) + i ];
+            decryption [ 4 * r + i ] =
+                    r == 0 || r == rounds
+                            ? w
+                            : td [ 0 ][ sbox [ byte ( w, 0 ) ] ]
+                                      ^ td [ 1 ][ sbox [ byte ( w, 1 ) ] ]
+                                      ^ td [ 2 ][ sbox [ byte ( w, 2 ) ] ]
+                                      ^ td [ 3 ][ sbox [ byte ( w, 3 ) ] ];
+        }
+    }
+    for ( std::size_t i = 0; i < encryption.size ( ); i++ )
+    {
+        store_word ( encryption_bytes.data ( ) + 4 * i, encryption [ i ] );
+        store_word ( decryption_bytes.data ( ) + 4 * i, decryption [ i ] );
+    }
+}
+
+void aes::cipher::ctr ( block const        &counter,
+                        std::uint8_t const *in,
+                        std::uint8_t       *out,
+                        std::size_t const   bytes ) const
+{
+    switch ( kind )
+    {
+#if defined( __x86_64__ )
+        case path::aesni:
+            aesni::ctr ( encryption_bytes.data ( ), counter, in, out, bytes );
+            break;
+        case path::vaes:
+            vaes::ctr ( encryption_bytes.data ( ), counter, in, out, bytes );
+            break;
+#endif
+        default: portable::ctr ( encryption, counter, in, out, bytes ); break;
+    }
+}
+
+void aes::cipher::cbc_encrypt ( block const        &iv,
+                                std::uint8_t const *in,
+                                std::uint8_t       *out,
+                                std::size_t const   bytes ) const
+{
+    switch ( kind )
+    {
+#if defined( __x86_64__ )
+        case path::aesni:
+        case path::vaes:
+            aesni::cbc_encrypt (
+                    encryption_bytes.data ( ), iv, in, out, bytes );
+            break;
+#endif
+        default:
+            portable::cbc_encrypt ( encryption, iv, in, out, bytes );
+            break;
+    }
+}
+
+void aes::cipher::cbc_decrypt ( block const        &iv,
+                                std::uint8_t const *in,
+                                std::uint8_t       *out,
+                                std::size_t const   bytes ) const
+{
+    switch ( kind )
+    {
+#if defined( __x86_64__ )
+        case path::aesni:
+            aesni::cbc_decrypt (
+                    decryption_bytes.data ( ), iv, in, out, bytes );
+            break;
+        case path::vaes:
+            vaes::cbc_decrypt ( decryption_bytes.data ( ), iv, in, out, bytes );
+            break;
+#endif
+        default:
+            portable::cbc_decrypt ( decryption, iv, in, out, bytes );
+            break;
+    }
+}
+
+namespace
+{
+    std::vector< std::uint8_t > hex ( std::string const &text )
+    {
+        std::vector< std::uint8_t > result;
+        for ( std::size_t i = 0; i + 1 < text.size ( ); i += 2 )
+        {
+            result.push_back ( std::uint8_t (
+                    std::stoul ( text.substr ( i, 2 ), nullptr, 16 ) ) );
+        }
+        return result;
+    }
+
+    template < std::size_t size >
+    std::array< std::uint8_t, size > hex_array ( std::string const &text )
+    {
+        std::array< std::uint8_t, size > result { };
+        auto const                       bytes = hex ( text );
+        std::copy ( bytes.begin ( ), bytes.end ( ), result.begin ( ) );
+        return result;
+    }
+
+    /**
+     * @brief Whether the path gets the answers that the standards do: the
+     * AES-256 example of FIPS-197 appendix C.3, and the CBC-AES256 and
+     * CTR-AES256 examples of SP 800-38A appendix F, both ways. The SP 800-38A
+     * examples are four blocks, too few for the wide loops, so they are also
+     * run over 64 copies of themselves, which the table path must agree with.
+     */
+    bool known_answers ( aes::path const p )
+    {
+        using octets     = std::vector< std::uint8_t >;
+        auto const check = [] ( aes::cipher const &c,
+                                std::string const &mode,
+                                aes::block const  &start,
+                                octets const      &plain,
+                                octets const      &expected ) {
+            octets out ( plain.size ( ) );
+            octets back ( plain.size ( ) );
+            if ( mode == "ctr" )
+            {
+                c.ctr ( start, plain.data ( ), out.data ( ), out.size ( ) );
+                c.ctr ( start, out.data ( ), back.data ( ), back.size ( ) );
+            } else
+            {
+                c.cbc_encrypt (
+                        start, plain.data ( ), out.data ( ), out.size ( ) );
+                c.cbc_decrypt (
+                        start, out.data ( ), back.data ( ), back.size ( ) );
+            }
+            return out == expected && back == plain;
+        };
+
+        aes::key const fips_key = hex_array< aes::key_bytes > (
+                "000102030405060708090a0b0c0d0e0f"
+                "101112131415161718191a1b1c1d1e1f" );
+        aes::cipher const fips { p, fips_key };
+        aes::block const  zero { };
+        // one block of CBC from a zero IV is the cipher itself.
+        if ( !check ( fips,
+                      "cbc",
+                      zero,
+                      hex ( "00112233445566778899aabbccddeeff" ),
+                      hex ( "8ea2b7ca516745bfeafc49904b496089" ) ) )
+        {
+            return false;
+        }
+
+        aes::key const    sp_key = hex_array< aes::key_bytes > (
+                "603deb1015ca71be2b73aef0857d7781"
+                "1f352c073b6108d72d9810a30914dff4" );
+        aes::cipher const sp { p, sp_key };
+        auto const        plain = hex ( "6bc1bee22e409f96e93d7e117393172a"
+                                        "ae2d8a571e03ac9c9eb76fac45af8e51"
+                                        "30c81c46a35ce411e5fbc1191a0a52ef"
+                                        "f69f2445df4f9b17ad2b417be66c3710" );
+        if ( !check ( sp,
+                      "cbc",
+                      hex_array< aes::block_bytes > (
+                              "000102030405060708090a0b0c0d0e0f" ),
+                      plain,
+                      hex ( "f58c4c04d6e5f1ba779eabfb5f7bfbd6"
+                            "9cfc4e967edb808d679f777bc6702c7d"
+                            "39f23369a9d9bacfa530e26304231461"
+                            "b2eb05e2c39be9fcda6c19078c6a9d1b" ) )
+             || !check ( sp,
+                         "ctr",
+                         hex_array< aes::block_bytes > (
+                                 "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff" ),
+                         plain,
+                         hex ( "601ec313775789a5b7a7f504bbf3d228"
+                               "f443e3ca4d62b59aca84e990cacaf5c5"
+                               "2b0930daa23de94ce87017ba2d84988d"
+                               "dfc9c58db67aada613c2dd08457941a6" ) ) )
+        {
+            return false;
+        }
+
+        // long enough for every loop and tail, and a CTR that ends mid-block.
+        octets longer;
+        for ( std::size_t i = 0; i < 64; i++ )
+        {
+            longer.insert ( longer.end ( ), plain.begin ( ), plain.end ( ) );
+        }
+        aes::cipher const reference { aes::path::table, sp_key };
+        for ( std::string const mode : { "ctr", "cbc" } )
+        {
+            std::size_t const bytes =
+                    mode == "ctr" ? longer.size ( ) - 3 : longer.size ( );
+            octets const     input ( longer.begin ( ),
+                                 longer.begin ( ) + bytes );
+            octets           expected ( bytes );
+            aes::block const start = hex_array< aes::block_bytes > (
+                    "f0f1f2f3f4f5f6f7fffffffffffffff0" );
+            if ( mode == "ctr" )
+            {
+                reference.ctr ( start,
+                                input.data ( ),
+                                expected.data ( ),
+                                bytes );
+            } else
+            {
+                reference.cbc_encrypt ( start,
+                                        input.data ( ),
+                                        expected.data ( ),
+                                        bytes );
+            }
+            if ( !check ( sp, mode, start, input, expected ) )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+} // namespace
+
+std::string const &aes::unavailable ( path const p )
+{
+    static std::string const none;
+    static std::string const failed [] = {
+            "the table path fails its known-answer tests",
+            "the AES-NI path fails its known-answer tests",
+            "the VAES path fails its known-answer tests",
+    };
+    static bool const passed [] = {
+            known_answers ( path::table ),
+            markbench::cpu::needs_aes ( ).empty ( )
+                    && known_answers ( path::aesni ),
+            markbench::cpu::needs_vaes ( ).empty ( )
+                    && known_answers ( path::vaes ),
+    };
+    switch ( p )
+    {
+        case path::aesni:
+            if ( !markbench::cpu::needs_aes ( ).empty ( ) )
+            {
+                return markbench::cpu::needs_aes ( );
+            }
+            break;
+        case path::vaes:
+            if ( !markbench::cpu::needs_vaes ( ).empty ( ) )
+            {
+                return markbench::cpu::needs_vaes ( );
+            }
+            break;
+        default: break;
+    }
+    return passed [ unsigned ( p ) ] ? none : failed [ unsigned ( p ) ];
+}
+
+namespace
+{
+    enum class mode
+    {
+        ctr,
+        cbc_encrypt,
+        cbc_decrypt,
+    };
+
+    std::string mode_name ( mode const m )
+    {
+        switch ( m )
+        {
+            case mode::ctr: return "ctr";
+            case mode::cbc_encrypt: return "cbc_encrypt";
+            case mode::cbc_decrypt: return "cbc_decrypt";
+            default: return "?";
+        }
+    }
+
+    /**
+     * @brief The per-thread fixture of an AES test: a random key, counter or
+     * IV, and buffer, which every iteration encrypts or decrypts in place.
+     */
+    template < mode m, aes::path p, std::size_t bytes > class encryption
+    {
+        std::vector< std::uint8_t > buffer;
+        aes::block                  start;
+        aes::cipher                 cipher;
+
+        static aes::key random_key ( )
+        {
+            aes::key result;
+            markbench::entropy::fill ( result.data ( ), result.size ( ) );
+            return result;
+        }
+    public:
+        encryption ( ) : buffer ( bytes ), cipher { p, random_key ( ) }
+        {
+            markbench::entropy::fill ( buffer.data ( ), buffer.size ( ) );
+            markbench::entropy::fill ( start.data ( ), start.size ( ) );
+        }
+
+        void operator( ) ( )
+        {
+            if constexpr ( m == mode::ctr )
+            {
+                cipher.ctr ( start, buffer.data ( ), buffer.data ( ), bytes );
+            } else if constexpr ( m == mode::cbc_encrypt )
+            {
+                cipher.cbc_encrypt (
+                        start, buffer.data ( ), buffer.data ( ), bytes );
+            } else
+            {
+                cipher.cbc_decrypt (
+                        start, buffer.data ( ), buffer.data ( ), bytes );
+            }
+            keep_result ( buffer [ 0 ] );
+        }
+    };
+
+    template < mode m, aes::path p, std::size_t bytes >
+    individual_test encryption_test ( )
+    {
+        individual_test result = fixture_test< encryption< m, p, bytes > > (
+                "test.aes." + mode_name ( m ) + "." + aes::path_name ( p ) + "."
+                + std::to_string ( bytes ) );
+        result.unavailable = [] ( ) -> std::string const & {
+            return aes::unavailable ( p );
+        };
+        result.bytes = bytes;
+        return result;
+    }
+
+    template < mode m, aes::path p > void add_sizes ( test_suite &suite )
+    {
+        constexpr std::size_t kibibyte = 1024;
+        suite.push_back ( encryption_test< m, p, 64 > ( ) );
+        suite.push_back ( encryption_test< m, p, kibibyte > ( ) );
+        suite.push_back ( encryption_test< m, p, 16 * kibibyte > ( ) );
+        suite.push_back ( encryption_test< m, p, kibibyte * kibibyte > ( ) );
+    }
+} // namespace
+
+test_suite aes::suite ( )
+{
+    test_suite result;
+    add_sizes< mode::ctr, path::table > ( result );
+    add_sizes< mode::ctr, path::aesni > ( result );
+    add_sizes< mode::ctr, path::vaes > ( result );
+    add_sizes< mode::cbc_encrypt, path::table > ( result );
+    add_sizes< mode::cbc_encrypt, path::aesni > ( result );
+    add_sizes< mode::cbc_decrypt, path::table > ( result );
+    add_sizes< mode::cbc_decrypt, path::aesni > ( result );
+    add_sizes< mode::cbc_decrypt, path::vaes > ( result );
+    return result;
+}
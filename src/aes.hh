@@ -0,0 +1,92 @@
+/**
+ * @file aes.hh
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief AES-256 in CTR and CBC modes, in portable code with lookup tables
+ * and with the AES-NI and VAES instructions, picked when the processor has
+ * them.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+#pragma once
+
+#include "test-suite.hh"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace markbench::aes
+{
+    inline constexpr std::size_t block_bytes = 16;
+    inline constexpr std::size_t key_bytes   = 32;
+    inline constexpr std::size_t rounds      = 14;
+
+    using block = std::array< std::uint8_t, block_bytes >;
+    using key   = std::array< std::uint8_t, key_bytes >;
+
+    enum class path
+    {
+        // the four 1 KiB T-tables, on any processor.
+        table,
+        // one block per register, eight at a time where the mode allows.
+        aesni,
+        // two blocks per 256-bit register, sixteen at a time. CBC
+        // encryption cannot use it, since every block waits on the last.
+        vaes,
+    };
+
+    // "table", "aesni" or "vaes".
+    std::string path_name ( path const p );
+
+    /**
+     * @brief Why the path cannot run here, or empty if it can. A path that
+     * the processor has but that fails the known-answer tests of FIPS-197
+     * and SP 800-38A cannot run either.
+     */
+    std::string const &unavailable ( path const p );
+
+    /**
+     * @brief A key, expanded for one path. Every mode works in place. CBC
+     * takes whole blocks only and does no padding. CTR counts in the last 64
+     * bits of the counter block, big-endian, and can end on part of a block.
+     */
+    class cipher
+    {
+        path                                             kind;
+        // the key schedule and the equivalent inverse cipher's, as 32-bit
+        // big-endian words for the tables and as bytes for the instructions.
+        std::array< std::uint32_t, 4 * ( rounds + 1 ) > encryption;
+        std::array< std::uint32_t, 4 * ( rounds + 1 ) > decryption;
+        alignas ( 16 ) std::array< std::uint8_t, block_bytes * ( rounds + 1 ) >
+                encryption_bytes;
+        alignas ( 16 ) std::array< std::uint8_t, block_bytes * ( rounds + 1 ) >
+                decryption_bytes;
+    public:
+        cipher ( path const p, key const &k );
+
+        void ctr ( block const        &counter,
+                   std::uint8_t const *in,
+                   std::uint8_t       *out,
+                   std::size_t const   bytes ) const;
+        void cbc_encrypt ( block const        &iv,
+                           std::uint8_t const *in,
+                           std::uint8_t       *out,
+                           std::size_t const   bytes ) const;
+        void cbc_decrypt ( block const        &iv,
+                           std::uint8_t const *in,
+                           std::uint8_t       *out,
+                           std::size_t const   bytes ) const;
+    };
+
+    /**
+     * @brief Encryption and decryption of buffers of random bytes from 64 B
+     * to 1 MiB, named test.aes.<mode>.<path>.<bytes>, where the mode is ctr,
+     * cbc_encrypt or cbc_decrypt.
+     */
+    test_suite suite ( );
+} // namespace markbench::aes
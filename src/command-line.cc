@@ -0,0 +1,455 @@
+/**
+ * @file command-line.cc
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Parses the command line.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+
+#include "command-line.hh"
+
+#include "aes.hh"
+#include "entropy.hh"
+#include "hashing.hh"
+#include "heap.hh"
+#include "instructions.hh"
+#include "isa-dispatch.hh"
+#include "isolation.hh"
+#include "memory-latency.hh"
+#include "primes.hh"
+#include "stream.hh"
+#include "timing.hh"
+#include "topology.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace command_line = markbench::command_line;
+
+/**
+ * @brief The whole of text as a non-negative integer, up to maximum.
+ * @throw std::invalid_argument naming argument otherwise.
+ */
+static unsigned long long whole_number (
+        std::string const       &argument,
+        std::string const       &text,
+        unsigned long long const maximum =
+                std::numeric_limits< unsigned long long >::max ( ) )
+{
+    std::size_t        used  = 0;
+    unsigned long long value = 0;
+    try
+    {
+        value = std::stoull ( text, &used );
+    } catch ( std::exception const & )
+    {
+        used = 0;
+    }
+    if ( used == 0 || used != text.size ( ) || text.front ( ) == '-' )
+    {
+        throw std::invalid_argument ( "Expected a whole number in "
+                                      + argument );
+    }
+    if ( value > maximum )
+    {
+        throw std::invalid_argument ( "Expected at most "
+                                      + std::to_string ( maximum ) + " in "
+                                      + argument );
+    }
+    return value;
+}
+
+/**
+ * @brief The whole of text as a non-negative number of seconds.
+ * @throw std::invalid_argument naming argument otherwise.
+ */
+static markbench::test_duration seconds ( std::string const &argument,
+                                          std::string const &text )
+{
+    std::size_t used  = 0;
+    long double value = -1;
+    try
+    {
+        value = std::stold ( text, &used );
+    } catch ( std::exception const & )
+    {
+        used = 0;
+    }
+    if ( used == 0 || used != text.size ( ) || !( value >= 0 ) )
+    {
+        throw std::invalid_argument ( "Expected a number of seconds in "
+                                      + argument );
+    }
+    return std::chrono::duration_cast< markbench::test_duration > (
+            std::chrono::duration< long double > ( value ) );
+}
+
+long double command_line::parse_number ( std::string const &argument,
+                                         std::string const &text )
+{
+    std::size_t used  = 0;
+    long double value = 0;
+    try
+    {
+        value = std::stold ( text, &used );
+    } catch ( std::exception const & )
+    {
+        used = 0;
+    }
+    if ( used == 0 || used != text.size ( ) || !std::isfinite ( value ) )
+    {
+        throw std::invalid_argument ( "Expected a number in " + argument );
+    }
+    return value;
+}
+
+bool command_line::glob_match ( std::string const &pattern,
+                                std::string const &text )
+{
+    // where the last '*' was, and where in text it currently matches up to,
+    // so that a mismatch can let it swallow one more character.
+    std::size_t p         = 0;
+    std::size_t t         = 0;
+    std::size_t star      = std::string::npos;
+    std::size_t swallowed = 0;
+    while ( t < text.size ( ) )
+    {
+        if ( p < pattern.size ( )
+             && ( pattern [ p ] == '?' || pattern [ p ] == text [ t ] ) )
+        {
+            p++;
+            t++;
+        } else if ( p < pattern.size ( ) && pattern [ p ] == '*' )
+        {
+            star      = p++;
+            swallowed = t;
+        } else if ( star != std::string::npos )
+        {
+            p = star + 1;
+            t = ++swallowed;
+        } else
+        {
+            return false;
+        }
+    }
+    while ( p < pattern.size ( ) && pattern [ p ] == '*' ) { p++; }
+    return p == pattern.size ( );
+}
+
+std::vector< markbench::thread_count >
+        command_line::parse_thread_counts ( std::string const &list )
+{
+    std::string const argument = "threads=" + list;
+    auto              count    = [ & ] ( std::string const &text ) {
+        thread_count result;
+        if ( text == "all" )
+        {
+            result = hardware_threads ( );
+        } else if ( text == "cores" )
+        {
+            result = topology::physical_cores ( );
+        } else
+        {
+            result = thread_count (
+                    whole_number ( argument, text, most_threads ) );
+        }
+        if ( result == 0 )
+        {
+            throw std::invalid_argument ( "Thread counts start at 1 in "
+                                          + argument );
+        }
+        return result;
+    };
+
+    std::vector< thread_count > result;
+    std::stringstream           entries { list };
+    std::string                 entry;
+    while ( std::getline ( entries, entry, ',' ) )
+    {
+        auto const dash = entry.find ( '-' );
+        if ( dash == std::string::npos )
+        {
+            result.push_back ( count ( entry ) );
+            continue;
+        }
+        thread_count const first = count ( entry.substr ( 0, dash ) );
+        thread_count const last  = count ( entry.substr ( dash + 1 ) );
+        if ( first > last )
+        {
+            throw std::invalid_argument ( "Backwards range " + entry + " in "
+                                          + argument );
+        }
+        for ( thread_count i = first; i <= last; i++ )
+        {
+            result.push_back ( i );
+        }
+    }
+    if ( result.empty ( ) )
+    {
+        throw std::invalid_argument ( "No thread counts in " + argument );
+    }
+    std::sort ( result.begin ( ), result.end ( ) );
+    result.erase ( std::unique ( result.begin ( ), result.end ( ) ),
+                   result.end ( ) );
+    return result;
+}
+
+command_line::settings command_line::parse ( int const     argc,
+                                             char        **argv,
+                                             std::ostream &notes )
+{
+    settings                   result;
+    auto                       make_suite = version_now;
+    std::vector< std::string > include;
+    std::vector< std::string > exclude;
+    result.version = version_now_name ( );
+
+    // a comma-separated list of globs.
+    auto globs = [] ( std::string const &list, auto &into ) {
+        std::stringstream entries { list };
+        std::string       entry;
+        while ( std::getline ( entries, entry, ',' ) )
+        {
+            into.push_back ( entry );
+        }
+    };
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        std::string const argument = argv [ i ];
+        auto const        equals   = argument.find ( '=' );
+        std::string const key      = argument.substr ( 0, equals );
+        std::string const value    = equals == std::string::npos
+                                           ? ""
+                                           : argument.substr ( equals + 1 );
+        auto             &options  = result.options;
+
+        if ( argument == "now" )
+        {
+            notes << "Set to run " << argument << "\n";
+            make_suite     = version_now;
+            result.version = version_now_name ( );
+        } else if ( argument == "000" )
+        {
+            notes << "Set to run " << argument << "\n";
+            make_suite     = version_000;
+            result.version = argument;
+        } else if ( argument == "001" )
+        {
+            notes << "Set to run " << argument << "\n";
+            make_suite     = version_001;
+            result.version = argument;
+        } else if ( argument == "aes" )
+        {
+            notes << "Set to run the AES-256 encryption tests\n";
+            make_suite     = markbench::aes::suite;
+            result.version = argument;
+        } else if ( argument == "hashing" )
+        {
+            notes << "Set to run the SHA-256 and CRC32C tests\n";
+            make_suite     = markbench::hashing::suite;
+            result.version = argument;
+        } else if ( argument == "primes" )
+        {
+            notes << "Set to run the segmented prime sieve tests\n";
+            make_suite     = markbench::primes::suite;
+            result.version = argument;
+        } else if ( argument == "entropy" )
+        {
+            notes << "Set to run the random number generator tests\n";
+            make_suite     = markbench::entropy::suite;
+            result.version = argument;
+        } else if ( argument == "heap" )
+        {
+            notes << "Set to run the allocator stress tests\n";
+            make_suite     = markbench::heap::suite;
+            result.version = argument;
+        } else if ( argument == "stream" )
+        {
+            notes << "Set to run the memory bandwidth tests\n";
+            make_suite     = markbench::stream::suite;
+            result.version = argument;
+        } else if ( argument == "memory-latency" )
+        {
+            notes << "Set to run the memory latency ladder\n";
+            make_suite     = markbench::memory_latency::suite;
+            result.version = argument;
+        } else if ( argument == "instructions" )
+        {
+            notes << "Set to run the instruction tests\n";
+            make_suite     = markbench::instructions::suite;
+            result.version = argument;
+        } else if ( argument == "sweep" )
+        {
+            notes << "Set to sweep thread counts\n";
+            options.thread_counts = test_runner::sweep_thread_counts ( );
+        } else if ( argument == "perf" )
+        {
+            notes << "Set to read performance counters\n";
+            options.performance_counters = true;
+        } else if ( argument == "latency" )
+        {
+            notes << "Set to time every iteration\n";
+            options.latency = true;
+        } else if ( argument == "rerun" )
+        {
+            notes << "Set to run throttled passes again\n";
+            options.rerun_throttled = true;
+        } else if ( argument == "isolate" )
+        {
+            if ( isolation::supported ( ) )
+            {
+                notes << "Set to run every pass in its own process\n";
+                options.isolate = true;
+            } else
+            {
+                notes << "Cannot run passes in their own processes here\n";
+            }
+        } else if ( argument == "list" )
+        {
+            result.list = true;
+        } else if ( argument == "help" || argument == "--help"
+                    || argument == "-h" )
+        {
+            result.help = true;
+        } else if ( topology::policy_from_name ( argument,
+                                                 options.placement ) )
+        {
+            notes << "Set to place threads " << argument << "\n";
+        } else if ( key == "include" )
+        {
+            globs ( value, include );
+        } else if ( key == "exclude" )
+        {
+            globs ( value, exclude );
+        } else if ( key == "threads" )
+        {
+            options.thread_counts = parse_thread_counts ( value );
+            notes << "Set to run at " << value << " threads\n";
+        } else if ( key == "duration" )
+        {
+            auto const longest = seconds ( argument, value );
+            if ( longest.count ( ) == 0 )
+            {
+                throw std::invalid_argument ( "A trial needs some time in "
+                                              + argument );
+            }
+            // a trial still stops early once it is precise enough.
+            options.length.maximum = longest;
+            options.length.minimum =
+                    std::min ( options.length.minimum, longest );
+            options.length.window = std::min ( options.length.window, longest );
+            notes << "Set to measure for at most " << value << " seconds\n";
+        } else if ( key == "trials" )
+        {
+            options.trials = whole_number ( argument, value );
+            if ( options.trials == 0 )
+            {
+                throw std::invalid_argument ( "At least one trial in "
+                                              + argument );
+            }
+            notes << "Set to run " << value << " trials\n";
+        } else if ( key == "warmup" )
+        {
+            options.warmup = seconds ( argument, value );
+            notes << "Set to warm up for " << value << " seconds\n";
+        } else if ( key == "throttle" )
+        {
+            long double const percent = parse_number ( argument, value );
+            if ( !( percent >= 0 && percent < 100 ) )
+            {
+                throw std::invalid_argument (
+                        "Expected a percentage from 0 up to 100 in "
+                        + argument );
+            }
+            options.throttle_limit = percent / 100;
+            notes << "Set to flag passes " << value << "% below the usual "
+                  << "clock\n";
+        } else if ( key == "timer" )
+        {
+            if ( value == "tsc" )
+            {
+                timing::prefer ( timing::source::tsc_rdtscp );
+            } else if ( value == "clock" )
+            {
+                timing::prefer ( timing::source::monotonic );
+            } else
+            {
+                throw std::invalid_argument ( "Unknown timer in "
+                                              + argument );
+            }
+            notes << "Set to time with the " << value << "\n";
+        } else if ( key == "isa" )
+        {
+            if ( value != "best" )
+            {
+                markbench::isa::force ( markbench::isa::parse_level ( value ) );
+            }
+            notes << "Set to run the " << value << " compute kernels\n";
+        } else if ( key == "seed" )
+        {
+            options.seed = rng::result_type ( whole_number (
+                    argument,
+                    value,
+                    std::numeric_limits< rng::result_type >::max ( ) ) );
+        } else if ( key == "format" )
+        {
+            if ( value == "text" )
+            {
+                result.format = output_format::text;
+            } else if ( value == "json" )
+            {
+                result.format = output_format::json;
+            } else if ( value == "csv" )
+            {
+                result.format = output_format::csv;
+            } else
+            {
+                throw std::invalid_argument ( "Unknown format in "
+                                              + argument );
+            }
+        } else if ( key == "json" )
+        {
+            result.json_path = value;
+            notes << "Set to write JSON to " << value << "\n";
+        } else if ( key == "csv" )
+        {
+            result.csv_path = value;
+            notes << "Set to write CSV to " << value << "\n";
+        } else
+        {
+            throw std::invalid_argument ( "Unknown argument " + argument );
+        }
+    }
+
+    auto matches = [] ( std::vector< std::string > const &patterns,
+                        std::string const                &id ) {
+        return std::any_of ( patterns.begin ( ),
+                             patterns.end ( ),
+                             [ & ] ( std::string const &pattern ) {
+                                 return glob_match ( pattern, id );
+                             } );
+    };
+    for ( auto const &t : make_suite ( ) )
+    {
+        if ( ( include.empty ( ) || matches ( include, t.name_id ) )
+             && !matches ( exclude, t.name_id ) )
+        {
+            result.suite.push_back ( t );
+        }
+    }
+    if ( result.suite.empty ( ) && !result.help )
+    {
+        throw std::invalid_argument ( "No test in suite " + result.version
+                                      + " is left to run" );
+    }
+    return result;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file command-line.hh
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Turns the command line into what to run and how.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+#pragma once
+
+#include "test-runner.hh"
+#include "test-suite.hh"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace markbench::command_line
+{
+    enum class output_format
+    {
+        // the progress and results as text, as the runner prints them.
+        text,
+        json,
+        csv,
+    };
+
+    struct settings
+    {
+        // the chosen tests of the chosen version, in suite order.
+        test_suite     suite;
+        std::string    version;
+        runner_options options;
+        output_format  format = output_format::text;
+        // where to write the results as well. Nowhere if empty.
+        std::string    json_path;
+        std::string    csv_path;
+        // print the ids of the chosen tests instead of running them.
+        bool           list = false;
+        bool           help = false;
+    };
+
+    /**
+     * @brief Reads every argument after the program name. See
+     * message_generator::usage for what they are.
+     * @param notes where to say what each argument changed.
+     * @throw std::invalid_argument naming the argument that makes no sense,
+     * or if no test is left to run.
+     */
+    settings parse ( int const argc, char **argv, std::ostream &notes );
+
+    /**
+     * @brief Whether text matches the whole of pattern, where '*' matches any
+     * run of characters and '?' any one character.
+     */
+    bool glob_match ( std::string const &pattern, std::string const &text );
+
+    /**
+     * @brief The most threads a pass may run on. Far more than any machine
+     * has, and few enough that a range of them expands quickly.
+     */
+    inline constexpr thread_count most_threads = 4096;
+
+    /**
+     * @brief A comma-separated list of thread counts and inclusive ranges,
+     * e.g., "1,2,4-8,all". "all" is every hardware thread and "cores" every
+     * physical core. Sorted, without duplicates.
+     * @throw std::invalid_argument if an entry is not a positive count or is
+     * more than most_threads.
+     */
+    std::vector< thread_count > parse_thread_counts ( std::string const &list );
+
+    /**
+     * @brief The whole of text, the value in argument, as a finite number.
+     * @throw std::invalid_argument naming argument otherwise, including when
+     * anything follows the number.
+     */
+    long double parse_number ( std::string const &argument,
+                               std::string const &text );
+} // namespace markbench::command_line
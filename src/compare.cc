@@ -0,0 +1,116 @@
+/**
+ * @file compare.cc
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Compares results files.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+
+#include "compare.hh"
+
+#include "json-reader.hh"
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace compare = markbench::compare;
+
+compare::result_file compare::load ( std::string const &path )
+{
+    std::ifstream file { path };
+    if ( !file )
+    {
+        throw std::runtime_error ( "Cannot read " + path );
+    }
+    std::stringstream text;
+    text << file.rdbuf ( );
+
+    result_file result;
+    try
+    {
+        json::value const document = json::parse ( text.str ( ) );
+        result.suite     = document [ "suite" ].as_string ( );
+        result.hostname  = document [ "host" ][ "hostname" ].as_string ( );
+        result.timestamp = document [ "host" ][ "timestamp" ].as_string ( );
+        for ( auto const &pass : document [ "passes" ].as_array ( ) )
+        {
+            pass_samples samples { pass [ "test" ].as_string ( ),
+                                   thread_count ( pass [ "threads" ]
+                                                          .as_number ( ) ),
+                                   { } };
+            for ( auto const &trial : pass [ "trials" ].as_array ( ) )
+            {
+                if ( !trial [ "rejected" ].as_bool ( )
+                     && !trial [ "rhedstones" ].is_null ( ) )
+                {
+                    samples.rhedstones.push_back (
+                            trial [ "rhedstones" ].as_number ( ) );
+                }
+            }
+            result.passes.push_back ( samples );
+        }
+    } catch ( std::exception const &e )
+    {
+        throw std::runtime_error ( path + " is not a markbench results file: "
+                                   + e.what ( ) );
+    }
+    return result;
+}
+
+std::vector< compare::comparison >
+        compare::compare ( result_file const &baseline,
+                           result_file const &current,
+                           thresholds const  &limits )
+{
+    if ( baseline.suite != current.suite )
+    {
+        throw std::runtime_error ( "Cannot compare suite " + baseline.suite
+                                   + " against suite " + current.suite );
+    }
+
+    std::vector< comparison > result;
+    for ( auto const &now : current.passes )
+    {
+        for ( auto const &then : baseline.passes )
+        {
+            if ( then.test != now.test || then.threads != now.threads )
+            {
+                continue;
+            }
+            auto const &a = then.rhedstones;
+            auto const &b = now.rhedstones;
+
+            comparison c { .test = now.test, .threads = now.threads };
+            c.baseline_mean = statistics::mean ( a );
+            c.current_mean  = statistics::mean ( b );
+            c.change        = c.baseline_mean > 0
+                                    ? c.current_mean / c.baseline_mean - 1
+                                    : std::nanl ( "" );
+            c.welch         = statistics::welch_t_test ( a, b );
+            c.mann_whitney  = statistics::mann_whitney_u_test ( a, b );
+            c.effect_size   = statistics::hedges_g ( a, b );
+
+            if ( std::isnan ( c.welch.p_value ) || std::isnan ( c.change ) )
+            {
+                c.outcome = verdict::inconclusive;
+            } else if ( c.welch.p_value < limits.significance
+                        && std::fabs ( c.change ) > limits.change )
+            {
+                c.outcome = c.change < 0 ? verdict::regressed
+                                         : verdict::improved;
+            } else
+            {
+                c.outcome = verdict::unchanged;
+            }
+            result.push_back ( c );
+            break;
+        }
+    }
+    return result;
+}
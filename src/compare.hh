@@ -0,0 +1,94 @@
+/**
+ * @file compare.hh
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Compares two results files, test by test, to find regressions.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+#pragma once
+
+#include "statistics.hh"
+#include "test.hh"
+
+#include <string>
+#include <vector>
+
+namespace markbench::compare
+{
+    /**
+     * @brief The kept (not outlier) trials of one pass, in rhedstones.
+     */
+    struct pass_samples
+    {
+        std::string         test;
+        thread_count        threads;
+        statistics::samples rhedstones;
+    };
+
+    /**
+     * @brief What compare needs out of a results file from write_json.
+     */
+    struct result_file
+    {
+        std::string                 suite;
+        std::string                 hostname;
+        std::string                 timestamp;
+        std::vector< pass_samples > passes;
+    };
+
+    /**
+     * @brief Reads a file written by results::write_json.
+     * @throw std::runtime_error if the file cannot be read or is not a
+     * results file.
+     */
+    result_file load ( std::string const &path );
+
+    enum class verdict
+    {
+        unchanged,
+        improved,
+        regressed,
+        // too few trials on one side to test anything.
+        inconclusive,
+    };
+
+    struct comparison
+    {
+        std::string                     test;
+        thread_count                    threads;
+        long double                     baseline_mean { };
+        long double                     current_mean { };
+        // (current - baseline) / baseline. Negative is slower.
+        long double                     change { };
+        statistics::test_outcome        welch { };
+        statistics::test_outcome        mann_whitney { };
+        // Hedges' g, current against baseline.
+        long double                     effect_size { };
+        verdict                         outcome { };
+    };
+
+    struct thresholds
+    {
+        // the p-value under which a difference is significant.
+        long double significance = 0.05L;
+        // the relative change a significant difference must also exceed to
+        // count as a regression or improvement.
+        long double change       = 0.05L;
+    };
+
+    /**
+     * @brief Compares every pass that both files have (same test, same
+     * thread count). A pass is regressed or improved only if Welch's t test
+     * finds the difference significant and the mean moved by more than the
+     * change threshold.
+     * @throw std::runtime_error if the files are from different suite
+     * versions, since the same test id may not be the same test.
+     */
+    std::vector< comparison > compare ( result_file const &baseline,
+                                        result_file const &current,
+                                        thresholds const  &limits );
+} // namespace markbench::compare
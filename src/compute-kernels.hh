@@ -0,0 +1,760 @@
+/**
+ * @file compute-kernels.hh
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief The kernels of the compute tests, in whatever namespace
+ * MARKBENCH_ISA_NAMESPACE names.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ * @note No include guard, on purpose: isa-dispatch.cc includes this once per
+ * x86-64 level, under that level's #pragma GCC target, so that every level
+ * gets its own copy of each kernel. Nothing else should include it.
+ */
+
+#include "isa-dispatch.hh"
+#include "test-utils.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#if !defined( MARKBENCH_ISA_NAMESPACE )
+#    error "Define MARKBENCH_ISA_NAMESPACE before including compute-kernels.hh"
+#endif
+
+namespace markbench::isa::MARKBENCH_ISA_NAMESPACE
+{
+    // credit: David Plummer.
+
+    /**
+     * @brief Essentially std::vector<bool>.
+     *
+     */
+    class bit_array
+    {
+        std::uint32_t *array;
+        std::size_t    size;
+
+        inline static constexpr std::size_t
+                array_size ( std::size_t const size )
+        {
+            return ( size >> 5 ) + ( ( size & 31 ) > 0 );
+        }
+
+        inline static constexpr std::size_t index ( std::size_t const n )
+        {
+            return ( n >> 5 );
+        }
+
+        inline static constexpr std::uint32_t
+                get_subindex ( std::size_t const n, std::uint32_t const d )
+        {
+            // I don't know why it's anding with 31 up there and modulo
+            // 32 down here, but that's what's in the Primes repository.
+            return d
+                 & std::uint32_t ( ( std::uint32_t ( 0x01 ) << ( n % 32 ) ) );
+        }
+
+        inline void set_false_subindex ( std::size_t n, std::uint32_t &d )
+        {
+            d &= ~std::uint32_t ( std::uint32_t ( 0x01 )
+                                  << ( n % ( 8 * sizeof ( std::uint32_t ) ) ) );
+        }
+    public:
+        explicit bit_array ( std::size_t size ) : size ( size )
+        {
+            array = new std::uint32_t [ array_size ( size ) ];
+            std::memset ( array, 0xFF, ( size >> 3 ) + ( ( size & 7 ) > 0 ) );
+        }
+
+        ~bit_array ( ) { delete [] array; }
+
+        bool get ( std::size_t n ) const
+        {
+            return get_subindex ( n, array [ index ( n ) ] );
+        }
+
+        static constexpr std::uint32_t rol ( std::uint32_t x, std::uint32_t n )
+        {
+            return ( x << n ) | ( x >> ( 32 - n ) );
+        }
+
+        void set_flags_false ( std::size_t n, std::size_t skip )
+        {
+            auto rolling_mask = ~std::uint32_t ( 1 << n % 32 );
+            auto roll_bits    = skip % 32;
+            while ( n < size )
+            {
+                array [ index ( n ) ] &= rolling_mask;
+                n += skip;
+                rolling_mask = rol ( rolling_mask, roll_bits );
+            }
+        }
+    };
+
+    bool valid_prime_count ( std::uint64_t const limit,
+                             std::uint64_t const count )
+    {
+        // the amount of primes below a certain power of 10. Here rather
+        // than a static member so that it is initialized by code built
+        // for this level, and only if this level runs.
+        static std::map< std::uint64_t const, std::uint64_t const > const
+                results = {
+                        { 10ULL, 4 },
+                        { 100ULL, 25 },
+                        { 1000ULL, 168 },
+                        { 10000ULL, 1229 },
+                        { 100000ULL, 9592 },
+                        { 1000000ULL, 78498 },
+                        { 10000000ULL, 664579 },
+                        { 100000000ULL, 5761455 },
+                        { 1000000000ULL, 50847534 },
+                        { 10000000000ULL, 455052511 },
+                };
+        return results.contains ( limit ) && results.at ( limit ) == count;
+    }
+
+    /**
+     * @brief Prime sieve.
+     *
+     */
+    class prime_sieve
+    {
+    private:
+        long      sieve_size = 0;
+        bit_array bits;
+    public:
+        prime_sieve ( long n ) : sieve_size ( n ), bits ( n ) { }
+        ~prime_sieve ( ) { }
+
+        bool validate_results ( )
+        {
+            return valid_prime_count ( sieve_size, count_primes ( ) );
+        }
+
+        void run_sieve ( )
+        {
+            int factor = 3;
+            int q      = ( int ) std::sqrt ( sieve_size );
+            while ( factor <= q )
+            {
+                for ( int num = factor; num < sieve_size; num += 2 )
+                {
+                    if ( bits.get ( num ) )
+                    {
+                        factor = num;
+                        break;
+                    }
+                }
+                bits.set_flags_false ( factor * factor, factor << 1 );
+                factor += 2;
+            }
+        }
+
+        int count_primes ( )
+        {
+            int count = ( sieve_size >= 2 );
+            for ( int i = 3; i < sieve_size; i += 2 )
+            {
+                if ( bits.get ( i ) )
+                {
+                    count++;
+                }
+            }
+            return count;
+        }
+    };
+
+    /**
+     * @brief Normalizes a vector to what could be a point in 3D space or a
+     * direction in 3D space. Normalization is critical for performing the
+     * cross-product as the magnitude of the cross product is related to the
+     * magnitudes of the two input vectors. Meaning that if we want to calculate
+     * the direction of a reflection and we do not use normalized vectors, we
+     * may get an erroneous value.
+     *
+     */
+    void isqrt ( )
+    {
+        // our vector.
+        static float vector [ 3 ] = { 0.1, 0.1, 0.1 };
+        // the changes in our values. Note that they have no common factors and
+        // that one has a different sign.
+        static float deltas [ 3 ] = { -0.1, 0.3, 0.5 };
+
+        // calculate the inverse square root.
+        float hypot = vector [ 0 ] * vector [ 0 ] + vector [ 1 ] * vector [ 1 ]
+                    + vector [ 2 ] * vector [ 2 ];
+        float normal [ 3 ] = {
+                vector [ 0 ] / std::sqrt ( hypot ),
+                vector [ 1 ] / std::sqrt ( hypot ),
+                vector [ 2 ] / std::sqrt ( hypot ),
+        };
+        // or the normalization is dead code, and the test times three adds.
+        keep_result ( normal [ 0 ] );
+        keep_result ( normal [ 1 ] );
+        keep_result ( normal [ 2 ] );
+
+        // at the end, change the vector.
+        for ( std::integral auto i = 0; i < 3; i++ )
+        {
+            vector [ i ] += deltas [ i ];
+        }
+    }
+
+
+    // copied from my own library-in-progress, ML, but written knowing that it's
+    // going to run in a C++ 20 environment.
+    template < std::floating_point F > class matrix
+    {
+        using column = std::vector< F >;
+        std::vector< column > rows;
+    public:
+        // no relation to the racing title originally released for the SNES,
+        // lol.
+        static constexpr F zero = F { 0 };
+        // no relation to the racing (league?).
+        static constexpr F one  = F { 1 };
+
+        matrix ( ) = default;
+
+        explicit matrix ( std::vector< column > rows ) :
+                rows { std::move ( rows ) }
+        { }
+        matrix ( std::integral auto const &rows,
+                 std::integral auto const &cols )
+        {
+            for ( std::integral auto i = 0; i < rows; i++ )
+            {
+                column col { };
+                for ( std::integral auto j = 0; j < cols; j++ )
+                {
+                    col.push_back ( F { 0 } );
+                }
+                this->rows.push_back ( col );
+            }
+        }
+
+        std::integral auto const row_count ( ) const noexcept
+        {
+            return rows.size ( );
+        }
+
+        std::integral auto const col_count ( ) const noexcept
+        {
+            return rows.at ( 0 ).size ( );
+        }
+
+        std::ranges::range auto &operator[] ( std::integral auto const &index )
+        {
+            return rows.at ( index );
+        }
+
+        std::ranges::range auto const &
+                operator[] ( std::integral auto const &index ) const
+        {
+            return rows.at ( index );
+        }
+
+        std::random_access_iterator auto begin ( ) noexcept
+        {
+            return rows.begin ( );
+        }
+
+        std::random_access_iterator auto begin ( ) const noexcept
+        {
+            return rows.begin ( );
+        }
+
+        std::random_access_iterator auto end ( ) noexcept
+        {
+            return rows.end ( );
+        }
+
+        std::random_access_iterator auto end ( ) const noexcept
+        {
+            return rows.end ( );
+        }
+
+        std::random_access_iterator auto cbegin ( ) const noexcept
+        {
+            return rows.cbegin ( );
+        }
+
+        std::random_access_iterator auto cend ( ) const noexcept
+        {
+            return rows.cend ( );
+        }
+
+        std::random_access_iterator auto rbegin ( ) noexcept
+        {
+            return rows.rbegin ( );
+        }
+
+        std::random_access_iterator auto rend ( ) noexcept
+        {
+            return rows.rend ( );
+        }
+
+        std::random_access_iterator auto crbegin ( ) const noexcept
+        {
+            return rows.crbegin ( );
+        }
+
+        std::random_access_iterator auto crend ( ) const noexcept
+        {
+            return rows.crend ( );
+        }
+
+        static inline matrix identity ( std::integral auto const &size )
+        {
+            matrix output { size, size };
+            for ( std::integral auto i = 0; i < size; i++ )
+            {
+                output [ i ][ i ] = one;
+            }
+            return output;
+        }
+
+        template < std::floating_point G,
+                   std::floating_point H = decltype ( F { 0 } + G { 0 } ) >
+        matrix< H > operator+ ( matrix< G > const &that ) const
+        {
+            if ( row_count ( ) != that.row_count ( ) )
+            {
+                throw std::out_of_range ( "Row size mismatch" );
+            }
+            if ( col_count ( ) != that.col_count ( ) )
+            {
+                throw std::out_of_range ( "Col size mismatch" );
+            }
+
+            matrix< H > output { row_count ( ), col_count ( ) };
+
+            // I really wish I could have made these two loops from a structured
+            // binding declaration, unfortunately, there's no way to do that
+            // without either discarding the result or discarding the qualifiers
+            // on *this and that.
+            for ( std::integral auto i = 0; i < row_count ( ); i++ )
+            {
+                for ( std::integral auto j = 0; j < col_count ( ); j++ )
+                {
+                    output [ i ][ j ] = rows [ i ][ j ] + that [ i ][ j ];
+                }
+            }
+
+            return output;
+        }
+
+        template < std::floating_point G,
+                   std::floating_point H = decltype ( F { 0 } + G { 0 } ) >
+        matrix< H > operator- ( matrix< G > const &that ) const
+        {
+            if ( row_count ( ) != that.row_count ( ) )
+            {
+                throw std::out_of_range ( "Row size mismatch" );
+            }
+            if ( col_count ( ) != that.col_count ( ) )
+            {
+                throw std::out_of_range ( "Col size mismatch" );
+            }
+
+            matrix< H > output { row_count ( ), col_count ( ) };
+
+            // I really wish I could have made these two loops from a structured
+            // binding declaration, unfortunately, there's no way to do that
+            // without either discarding the result or discarding the qualifiers
+            // on *this and that.
+            for ( std::integral auto i = 0; i < row_count ( ); i++ )
+            {
+                for ( std::integral auto j = 0; j < col_count ( ); j++ )
+                {
+                    output [ i ][ j ] = rows [ i ][ j ] - that [ i ][ j ];
+                }
+            }
+
+            return output;
+        }
+
+        template < std::floating_point G,
+                   std::floating_point H = decltype ( F { 0 } + G { 0 } ) >
+        matrix< H > operator* ( matrix< G > const &that ) const
+        {
+            if ( col_count ( ) != that.row_count ( ) )
+            {
+                throw std::out_of_range ( "Matrix size mismatch" );
+            }
+
+            matrix< H > output { row_count ( ), that.col_count ( ) };
+
+            for ( std::integral auto i = 0; i < row_count ( ); i++ )
+            {
+                for ( std::integral auto j = 0; j < that.col_count ( ); j++ )
+                {
+                    H accumulated = H { 0 };
+                    for ( std::integral auto k = 0; k < col_count ( ); k++ )
+                    {
+                        accumulated += rows [ i ][ k ] * that [ k ][ j ];
+                    }
+                    output [ i ][ j ] = accumulated;
+                }
+            }
+            return output;
+        }
+
+        template < std::floating_point G,
+                   std::floating_point H = decltype ( F { 0 } + G { 0 } ) >
+        std::vector< H > operator* ( std::vector< G > const &that ) const
+        {
+            if ( that.size ( ) != col_count ( ) )
+            {
+                throw std::out_of_range ( "Vector / Matrix size mismatch" );
+            }
+            std::vector< H > output;
+            for ( auto const &row : *this )
+            {
+                H accumulated = H { 0 };
+                for ( std::integral auto i = 0; i < col_count ( ); i++ )
+                {
+                    accumulated += row [ i ] * that [ i ];
+                }
+                output.push_back ( accumulated );
+            }
+            return output;
+        }
+
+        template < std::floating_point G,
+                   std::floating_point H = decltype ( F { 0 } + G { 0 } ) >
+        matrix< H > operator* ( G const &scalar ) const
+        {
+            matrix< H > result { row_count ( ), col_count ( ) };
+            for ( std::integral auto i = 0; i < row_count ( ); i++ )
+            {
+                for ( std::integral auto j = 0; j < col_count ( ); j++ )
+                {
+                    result [ i ][ j ] = rows [ i ][ j ] * scalar;
+                }
+            }
+            return result;
+        }
+
+        template < std::floating_point G,
+                   std::floating_point H = decltype ( F { 0 } + G { 0 } ) >
+        matrix< H > operator/ ( G const &scalar ) const
+        {
+            return *this * ( G { 1 } / scalar );
+        }
+
+        template < std::floating_point G,
+                   std::floating_point H = decltype ( F { 0 } + G { 0 } ) >
+        matrix< H > augment ( matrix< G > const &that ) const
+        {
+            if ( row_count ( ) != that.row_count ( ) )
+            {
+                throw std::out_of_range ( "Row size mismatch" );
+            }
+
+            matrix< H > result { row_count ( ),
+                                 col_count ( ) + that.col_count ( ) };
+            // row major order, so we go by column-major order to copy it
+            // properly. so, we handle all of the columns in this and then all
+            // of the columns in that.
+
+            for ( std::integral auto i = 0; auto &row : result )
+            {
+                // columns from this
+                std::integral auto j = 0;
+
+                auto copy = [ & ] ( std::floating_point auto mem ) {
+                    result [ i ][ j++ ] = mem;
+                };
+                std::for_each (
+                        rows [ i ].begin ( ), rows [ i ].end ( ), copy );
+                std::for_each (
+                        that [ i ].begin ( ), that [ i ].end ( ), copy );
+                i++;
+            }
+            return result;
+        }
+
+        matrix< F > echelon ( ) const
+        {
+            matrix< F > result = *this;
+
+            // function that simply eliminates negative 0: -0 + 0 is 0 and
+            // anything else plus 0 is itself. No branch, so that the loops it
+            // is in still vectorize.
+            auto eliminate_neg_zero = [ & ] ( F &x ) { x += zero; };
+
+            // if less than two rows or there are no columns, then we are
+            // already considered to be in echelon form since there is no
+            // reducing that we can do.
+            if ( result.row_count ( ) < 2 || result.col_count ( ) == 0 )
+            {
+                return result;
+            }
+
+            std::size_t const height             = row_count ( );
+            std::size_t const width              = col_count ( );
+            std::size_t const smallest_dimension = std::min ( height, width );
+            // the "forward" phase of transferring to rref form. Here we
+            // identify the pivot positions and move them to the proper place.
+            for ( std::size_t i = 0; i < smallest_dimension; i++ )
+            {
+                column &pivot = result.rows [ i ];
+                if ( pivot [ i ] == 0 )
+                {
+                    continue;
+                }
+                // make the diagonal value 1.
+                F factor = pivot [ i ];
+                for ( auto &x : pivot )
+                {
+                    x /= factor;
+                    eliminate_neg_zero ( x );
+                }
+                // eliminate the other elements in the column.
+                for ( std::size_t r = 0; r < height; r++ )
+                {
+                    if ( r == i )
+                    {
+                        continue;
+                    }
+                    column &row = result.rows [ r ];
+                    subtract_row (
+                            row.data ( ), pivot.data ( ), row [ i ], width );
+                    for ( auto &x : row ) { eliminate_neg_zero ( x ); }
+                }
+
+                // a plain loop rather than std::for_each, since the standard
+                // library's templates are built for the baseline and gcc will
+                // not inline this level's lambda into them, and an int rather
+                // than a bool, since gcc vectorizes an or of ints.
+                auto is_row_zero = [] ( column const &v ) -> bool {
+                    int any_nonzero = 0;
+                    for ( F const f : v ) { any_nonzero |= ( f != zero ); }
+                    return !any_nonzero;
+                };
+
+                // simple sorting to move the rows of zeros to the bottom
+                bool swapped;
+                do {
+                    swapped = false;
+                    for ( std::size_t r = 1; r < height; r++ )
+                    {
+                        if ( is_row_zero ( result.rows [ r - 1 ] )
+                             && !is_row_zero ( result.rows [ r ] ) )
+                        {
+                            std::swap ( result.rows [ r - 1 ],
+                                        result.rows [ r ] );
+                            swapped = true;
+                        }
+                    }
+                } while ( swapped );
+            }
+            // that was the forward phase. Now, all the rows have a pivot
+            // element or are all zeros. The next step is to make sure that each
+            // pivot column only has the pivot element and that all pivots are
+            // 1.0
+            for ( std::size_t r = 0; r < height; r++ )
+            {
+                column &pivot = result.rows [ r ];
+                for ( std::size_t c = 0; c < width; c++ )
+                {
+                    if ( pivot [ c ] != zero && pivot [ c ] != one )
+                    {
+                        F pivot_element = pivot [ c ];
+                        for ( auto &elem : pivot )
+                        {
+                            elem /= pivot_element;
+                        }
+                        for ( std::size_t i = 0; i < height; i++ )
+                        {
+                            if ( i == r )
+                            {
+                                continue;
+                            }
+                            column &row = result.rows [ i ];
+                            subtract_row ( row.data ( ),
+                                           pivot.data ( ),
+                                           row [ c ],
+                                           width );
+                        }
+                        break;
+                    }
+                }
+            }
+            return result;
+        }
+    private:
+        /**
+         * @brief row -= ratio * pivot. Every row is a vector of its own, but
+         * the compiler only knows that they do not overlap through
+         * __restrict, and without knowing it, it would not vectorize.
+         */
+        static void subtract_row ( F *__restrict row,
+                                   F const *__restrict pivot,
+                                   F const           ratio,
+                                   std::size_t const width )
+        {
+            for ( std::size_t j = 0; j < width; j++ )
+            {
+                row [ j ] -= ratio * pivot [ j ];
+            }
+        }
+    };
+
+    /**
+     * @brief Runs an iteration of the primes sieve.
+     *
+     */
+    void primes_sieve ( )
+    {
+        prime_sieve sieve ( 1000000L );
+        sieve.run_sieve ( );
+        // which also keeps the whole sieve from being dead code.
+        if ( !sieve.validate_results ( ) )
+        {
+            throw std::logic_error ( "The prime sieve miscounted the primes "
+                                     "below 1000000" );
+        }
+    }
+
+    // the primes that sieve_plan::presieve has already crossed off.
+    inline constexpr std::uint32_t wheel_primes [] = { 3, 5, 7, 11, 13 };
+
+    sieve_plan make_sieve_plan ( std::uint64_t const limit )
+    {
+        constexpr std::uint64_t span = 128 * sieve_segment_words;
+        sieve_plan              plan;
+        plan.limit    = limit;
+        plan.segments = ( limit + span - 1 ) / span;
+
+        // the odd primes up to the square root, by the plain sieve: at most
+        // 10^5 of them for 10^10.
+        std::uint64_t root = std::uint64_t ( std::sqrt ( double ( limit ) ) );
+        while ( root * root > limit ) { root--; }
+        while ( ( root + 1 ) * ( root + 1 ) <= limit ) { root++; }
+        std::vector< bool > composite ( root + 1 );
+        for ( std::uint64_t n = 3; n <= root; n += 2 )
+        {
+            if ( composite [ n ] )
+            {
+                continue;
+            }
+            for ( std::uint64_t m = n * n; m <= root; m += 2 * n )
+            {
+                composite [ m ] = true;
+            }
+            if ( n > wheel_primes [ std::size ( wheel_primes ) - 1 ]
+                 && n * n < limit )
+            {
+                plan.primes.push_back ( std::uint32_t ( n ) );
+            }
+        }
+
+        // bit i of word g is the odd number 2 * ( 64 * g + i ) + 1, which a
+        // wheel prime p divides when 64 * g + i is ( p - 1 ) / 2, mod p. The
+        // product of the wheel primes is odd, so the pattern repeats after
+        // that many words.
+        std::size_t period = 1;
+        for ( std::uint32_t const p : wheel_primes ) { period *= p; }
+        plan.presieve.assign ( period, ~std::uint64_t ( 0 ) );
+        for ( std::uint32_t const p : wheel_primes )
+        {
+            for ( std::uint64_t i = ( p - 1 ) / 2; i < 64 * period; i += p )
+            {
+                plan.presieve [ i >> 6 ] &=
+                        ~( std::uint64_t ( 1 ) << ( i & 63 ) );
+            }
+        }
+        return plan;
+    }
+
+    std::uint64_t sieve_segment ( sieve_plan const   &plan,
+                                  std::uint64_t const segment,
+                                  std::uint64_t      *bits )
+    {
+        constexpr std::uint64_t span = 128 * sieve_segment_words;
+        // bit i is the odd number low + 2 * i + 1.
+        std::uint64_t const low  = segment * span;
+        std::uint64_t const high = std::min ( low + span, plan.limit );
+
+        std::size_t const period = plan.presieve.size ( );
+        std::size_t const start  = segment * sieve_segment_words % period;
+        for ( std::size_t done = 0; done < sieve_segment_words; )
+        {
+            std::size_t const from = ( start + done ) % period;
+            std::size_t const part =
+                    std::min ( sieve_segment_words - done, period - from );
+            std::memcpy ( bits + done,
+                          plan.presieve.data ( ) + from,
+                          part * sizeof ( std::uint64_t ) );
+            done += part;
+        }
+
+        for ( std::uint64_t const p : plan.primes )
+        {
+            std::uint64_t first = p * p;
+            if ( first >= high )
+            {
+                break;
+            }
+            if ( first < low )
+            {
+                // the first odd multiple from low.
+                first = ( low + p - 1 ) / p * p;
+                first += ( first & 1 ) ? 0 : p;
+            }
+            for ( std::uint64_t i = ( first - low ) / 2;
+                  i < 64 * sieve_segment_words;
+                  i += p )
+            {
+                bits [ i >> 6 ] &= ~( std::uint64_t ( 1 ) << ( i & 63 ) );
+            }
+        }
+
+        std::uint64_t count = 0;
+        if ( segment == 0 )
+        {
+            // 1 is not prime, and 2 and the wheel primes are.
+            bits [ 0 ] &= ~std::uint64_t ( 1 );
+            count += plan.limit > 2;
+            for ( std::uint32_t const p : wheel_primes )
+            {
+                count += p < plan.limit;
+            }
+        }
+        // the odd numbers below high. __builtin_popcountll rather than
+        // std::popcount, which would be instantiated once, for the baseline.
+        std::uint64_t const odd   = ( high - low ) / 2;
+        std::size_t const   whole = odd / 64;
+        for ( std::size_t w = 0; w < whole; w++ )
+        {
+            count += __builtin_popcountll ( bits [ w ] );
+        }
+        if ( odd % 64 )
+        {
+            std::uint64_t const mask =
+                    ( std::uint64_t ( 1 ) << ( odd % 64 ) ) - 1;
+            count += __builtin_popcountll ( bits [ whole ] & mask );
+        }
+        return count;
+    }
+
+    template < std::floating_point F > F echelon ( matrix_rows< F > const &m )
+    {
+        return matrix< F > { m }.echelon ( ) [ 0 ][ 0 ];
+    }
+} // namespace markbench::isa::MARKBENCH_ISA_NAMESPACE
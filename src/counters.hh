@@ -0,0 +1,191 @@
+/**
+ * @file counters.hh
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Per-thread iteration counters that stay out of each other's way.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace markbench
+{
+    /**
+     * @brief How far apart two counters must be to never share a cache line.
+     * @note 128 instead of 64 since Intel's adjacent-line prefetcher pulls in
+     * cache lines in pairs and Apple's cores use 128-byte lines anyways.
+     * std::hardware_destructive_interference_size would be nicer, but g++-10
+     * does not have it.
+     */
+    inline constexpr std::size_t cache_line = 128;
+
+    /**
+     * @brief One thread's published iteration count. Each slot owns its whole
+     * cache line so that publishing a count never invalidates another thread's
+     * slot.
+     * @details published is the running count, which the thread keeps
+     * updating in batches. epoch is the last measurement window the thread
+     * acknowledged, and window_count is exactly the number of iterations that
+     * thread completed before it saw that window begin. Only acknowledging
+     * writes window_count, so it stays put while the thread runs on.
+     */
+    struct alignas ( cache_line ) counter_slot
+    {
+        std::atomic_uintmax_t published       = 0;
+        std::atomic_uintmax_t epoch           = 0;
+        std::atomic_uintmax_t window_count    = 0;
+        // nanoseconds spent on untimed work (see local_counter::exclude),
+        // published alongside the count, and as of the acknowledged window.
+        std::atomic_uintmax_t excluded        = 0;
+        std::atomic_uintmax_t window_excluded = 0;
+    };
+
+    /**
+     * @brief The counter that a test thread actually increments. Counting
+     * happens in a plain integer (which the compiler keeps in a register) and
+     * only every batch iterations does the count go out to the slot. Only the
+     * owning thread ever writes to the slot, so publishing is a plain store
+     * instead of a locked read-modify-write.
+     */
+    class local_counter
+    {
+        counter_slot  &slot;
+        std::uintmax_t count    = 0;
+        std::uintmax_t excluded = 0;
+    public:
+        /**
+         * @brief Iterations between publishing. A power of two so that the
+         * check is a mask instead of a division.
+         */
+        static constexpr std::uintmax_t batch = 1024;
+
+        explicit local_counter ( counter_slot &slot ) : slot { slot } { }
+
+        ~local_counter ( ) { flush ( ); }
+
+        /**
+         * @brief Counts n iterations at once, publishing if that crossed a
+         * multiple of batch.
+         */
+        inline void advance ( std::uintmax_t const n ) noexcept
+        {
+            std::uintmax_t const before = count;
+            count += n;
+            if ( ( before & ~( batch - 1 ) ) != ( count & ~( batch - 1 ) ) )
+            {
+                flush ( );
+            }
+        }
+
+        std::uintmax_t value ( ) const noexcept { return count; }
+
+        /**
+         * @brief Takes time spent on untimed work (a fixture's reset) out of
+         * this thread's measured time.
+         */
+        inline void exclude ( std::uintmax_t const nanoseconds ) noexcept
+        {
+            excluded += nanoseconds;
+        }
+
+        /**
+         * @brief Publishes the exact count. Called at the end of a test so
+         * that the final result does not lose the last partial batch.
+         */
+        inline void flush ( ) noexcept
+        {
+            slot.excluded.store ( excluded, std::memory_order_relaxed );
+            slot.published.store ( count, std::memory_order_release );
+        }
+
+        /**
+         * @brief Records the exact count as the one at the start of the given
+         * measurement window.
+         */
+        inline void acknowledge ( std::uintmax_t const epoch ) noexcept
+        {
+            slot.window_count.store ( count, std::memory_order_relaxed );
+            slot.window_excluded.store ( excluded, std::memory_order_relaxed );
+            slot.epoch.store ( epoch, std::memory_order_release );
+        }
+    };
+
+    /**
+     * @brief The slots for every thread in a test.
+     */
+    class counter_bank
+    {
+        std::unique_ptr< counter_slot [] > slots;
+        std::size_t                        slot_count;
+    public:
+        explicit counter_bank ( std::size_t const threads ) :
+                slots { new counter_slot [ threads ] }, slot_count { threads }
+        { }
+
+        counter_slot &operator[] ( std::size_t const index )
+        {
+            return slots [ index ];
+        }
+
+        std::size_t size ( ) const noexcept { return slot_count; }
+
+        /**
+         * @brief Whether every thread has acknowledged the given window.
+         */
+        bool acknowledged ( std::uintmax_t const epoch ) const
+        {
+            for ( std::size_t i = 0; i < slot_count; i++ )
+            {
+                if ( slots [ i ].epoch.load ( std::memory_order_acquire )
+                     < epoch )
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief Every thread's count at the start of the window it last
+         * acknowledged. Once every thread has acknowledged the current window,
+         * these are the counts up to exactly that window, however far the
+         * threads have run since.
+         */
+        std::vector< std::uintmax_t > collect ( ) const
+        {
+            std::vector< std::uintmax_t > result;
+            for ( std::size_t i = 0; i < slot_count; i++ )
+            {
+                // ordered by the acquire load in acknowledged.
+                result.push_back ( slots [ i ].window_count.load (
+                        std::memory_order_relaxed ) );
+            }
+            return result;
+        }
+
+        /**
+         * @brief The untimed nanoseconds of every slot. Exact under the same
+         * conditions as collect.
+         */
+        std::vector< std::uintmax_t > collect_excluded ( ) const
+        {
+            std::vector< std::uintmax_t > result;
+            for ( std::size_t i = 0; i < slot_count; i++ )
+            {
+                // ordered by the acquire load in acknowledged.
+                result.push_back ( slots [ i ].window_excluded.load (
+                        std::memory_order_relaxed ) );
+            }
+            return result;
+        }
+    };
+} // namespace markbench
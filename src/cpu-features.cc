@@ -0,0 +1,158 @@
+/**
+ * @file cpu-features.cc
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Reads cpuid.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+
+#include "cpu-features.hh"
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+#    include <cpuid.h>
+#endif
+
+namespace cpu = markbench::cpu;
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+/**
+ * @brief The register state the operating system saves on a context switch,
+ * from xgetbv. Without the bits for a register file, the instructions that
+ * use it fault even if cpuid lists them.
+ */
+static unsigned long long saved_state ( )
+{
+    unsigned eax, edx;
+    asm volatile ( "xgetbv" : "=a"( eax ), "=d"( edx ) : "c"( 0 ) );
+    return ( ( unsigned long long ) edx << 32 ) | eax;
+}
+#endif
+
+static cpu::features read_features ( )
+{
+    cpu::features result;
+#if defined( __x86_64__ ) || defined( __i386__ )
+    unsigned eax, ebx, ecx, edx;
+    if ( !__get_cpuid ( 1, &eax, &ebx, &ecx, &edx ) )
+    {
+        return result;
+    }
+    result.sse4_2 = ecx & bit_SSE4_2;
+    result.popcnt = ecx & bit_POPCNT;
+    result.pclmul = ecx & bit_PCLMUL;
+    result.aes    = ecx & bit_AES;
+    // what x86-64-v2 adds to the baseline, besides popcnt and sse4.2.
+    bool const v2 = ( ecx & bit_SSE3 ) && ( ecx & bit_SSSE3 )
+                 && ( ecx & bit_SSE4_1 ) && ( ecx & bit_CMPXCHG16B );
+    // and what x86-64-v3 adds besides avx, avx2, bmi2 and fma.
+    bool v3 = ( ecx & bit_MOVBE ) && ( ecx & bit_F16C );
+
+    // xmm and ymm, then opmask and both halves of zmm.
+    bool const               osxsave   = ecx & bit_OSXSAVE;
+    unsigned long long const state     = osxsave ? saved_state ( ) : 0;
+    bool const               ymm_saved = ( state & 0x06 ) == 0x06;
+    bool const               zmm_saved = ( state & 0xe6 ) == 0xe6;
+    result.avx                         = ymm_saved && ( ecx & bit_AVX );
+    result.fma                         = result.avx && ( ecx & bit_FMA );
+
+    if ( __get_cpuid_max ( 0, nullptr ) >= 7 )
+    {
+        __cpuid_count ( 7, 0, eax, ebx, ecx, edx );
+        result.avx2       = result.avx && ( ebx & bit_AVX2 );
+        result.bmi2       = ebx & bit_BMI2;
+        result.sha        = ebx & bit_SHA;
+        result.vaes       = result.avx && ( ecx & bit_VAES );
+        result.vpclmulqdq = result.avx && ( ecx & bit_VPCLMULQDQ );
+        unsigned const avx512 = bit_AVX512F | bit_AVX512BW | bit_AVX512CD
+                              | bit_AVX512DQ | bit_AVX512VL;
+        result.avx512 = zmm_saved && ( ebx & avx512 ) == avx512;
+        v3 = v3 && ( ebx & bit_BMI );
+    }
+    bool lahf = false;
+    if ( __get_cpuid ( 0x80000001, &eax, &ebx, &ecx, &edx ) )
+    {
+        lahf = ecx & bit_LAHF_LM;
+        v3   = v3 && ( ecx & bit_LZCNT );
+    }
+#    if defined( __x86_64__ )
+    result.x86_64 = true;
+    result.level  = 1;
+    if ( v2 && lahf && result.popcnt && result.sse4_2 )
+    {
+        result.level = 2;
+        if ( v3 && result.avx2 && result.fma && result.bmi2 )
+        {
+            result.level = 3;
+            if ( result.avx512 )
+            {
+                result.level = 4;
+            }
+        }
+    }
+#    endif
+#endif
+    return result;
+}
+
+cpu::features const &cpu::detect ( )
+{
+    static features const result = read_features ( );
+    return result;
+}
+
+static std::string const none;
+
+std::string const &cpu::needs_x86_64 ( )
+{
+    static std::string const reason = "the processor is not x86-64";
+    return detect ( ).x86_64 ? none : reason;
+}
+
+std::string const &cpu::needs_avx ( )
+{
+    static std::string const reason = "the processor has no AVX";
+    return detect ( ).x86_64 && detect ( ).avx ? none : reason;
+}
+
+std::string const &cpu::needs_avx2 ( )
+{
+    static std::string const reason = "the processor has no AVX2";
+    return detect ( ).x86_64 && detect ( ).avx2 ? none : reason;
+}
+
+std::string const &cpu::needs_aes ( )
+{
+    static std::string const reason = "the processor has no AES-NI";
+    return detect ( ).x86_64 && detect ( ).aes ? none : reason;
+}
+
+std::string const &cpu::needs_vaes ( )
+{
+    static std::string const reason = "the processor has no VAES with AVX2";
+    features const          &f      = detect ( );
+    return f.x86_64 && f.aes && f.vaes && f.avx2 ? none : reason;
+}
+
+std::string const &cpu::needs_sha ( )
+{
+    static std::string const reason = "the processor has no SHA extensions";
+    features const          &f      = detect ( );
+    return f.x86_64 && f.sha && f.sse4_2 ? none : reason;
+}
+
+std::string const &cpu::needs_sse4_2 ( )
+{
+    static std::string const reason = "the processor has no SSE4.2";
+    return detect ( ).x86_64 && detect ( ).sse4_2 ? none : reason;
+}
+
+std::string const &cpu::needs_pclmul ( )
+{
+    static std::string const reason = "the processor has no PCLMULQDQ";
+    features const          &f      = detect ( );
+    return f.x86_64 && f.pclmul && f.sse4_2 ? none : reason;
+}
@@ -0,0 +1,64 @@
+/**
+ * @file cpu-features.hh
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Which instruction set extensions this processor (and its operating
+ * system) supports, from cpuid.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+#pragma once
+
+#include <string>
+
+namespace markbench::cpu
+{
+    /**
+     * @brief Each is true only if the processor has the extension and, for
+     * the vector ones, the operating system saves the registers it uses.
+     * All false on anything but x86.
+     */
+    struct features
+    {
+        bool x86_64 = false;
+        bool sse4_2 = false;
+        bool popcnt = false;
+        bool pclmul = false;
+        bool aes    = false;
+        bool avx    = false;
+        bool fma    = false;
+        bool avx2   = false;
+        bool bmi2   = false;
+        bool sha    = false;
+        bool vaes   = false;
+        bool vpclmulqdq = false;
+        // AVX-512 F, BW, CD, DQ and VL together, as x86-64-v4 needs.
+        bool avx512 = false;
+        // the highest x86-64 microarchitecture level (1 for the baseline, up
+        // to 4) that the processor has every feature of. 0 if not x86-64.
+        unsigned level = 0;
+    };
+
+    /**
+     * @brief Read once and then remembered.
+     */
+    features const &detect ( );
+
+    /**
+     * @brief Why a test that needs the given extension cannot run here, or
+     * empty if it can. For individual_test::unavailable.
+     */
+    std::string const &needs_x86_64 ( );
+    std::string const &needs_avx ( );
+    std::string const &needs_avx2 ( );
+    std::string const &needs_aes ( );
+    // VAES on 256-bit registers, which also needs AVX2.
+    std::string const &needs_vaes ( );
+    std::string const &needs_sha ( );
+    std::string const &needs_sse4_2 ( );
+    // PCLMULQDQ, and SSE4.2 to finish what it folds.
+    std::string const &needs_pclmul ( );
+} // namespace markbench::cpu
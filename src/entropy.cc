@@ -0,0 +1,180 @@
+/**
+ * @file entropy.cc
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Asks the operating system for random bytes.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+
+#include "entropy.hh"
+#include "test-utils.hh"
+
+#if defined( LINUX ) || defined( DARWIN )
+#    include <sys/random.h>
+#    include <unistd.h>
+
+#    include <cerrno>
+#else
+#    ifndef UNICODE
+#        define UNICODE 1
+#    endif
+#    include "windows.h"
+
+#    include <bcrypt.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <system_error>
+
+namespace entropy = markbench::entropy;
+
+#if !defined( LINUX ) && !defined( DARWIN )
+namespace
+{
+    /**
+     * @brief Since markbench is built on mingw and the linker, by default,
+     * cannot find Bcrypt.dll, we have to not only explicitly link with it in
+     * the command line but dynamically load it, once, for as long as the
+     * program runs.
+     */
+    class bcrypt_library
+    {
+        HMODULE bcrypt = NULL;
+    public:
+        bcrypt_library ( ) { bcrypt = LoadLibrary ( L"Bcrypt.dll" ); }
+
+        ~bcrypt_library ( ) { FreeLibrary ( bcrypt ); }
+    };
+} // namespace
+#endif
+
+void entropy::fill ( std::uint8_t *const start, std::size_t const count )
+{
+    std::size_t done = 0;
+#if defined( LINUX )
+    // getrandom only promises whole requests up to 256 bytes, and a signal
+    // can cut a bigger one short.
+    while ( done < count )
+    {
+        ssize_t const got = getrandom ( start + done, count - done, 0 );
+        if ( got < 0 )
+        {
+            if ( errno == EINTR )
+            {
+                continue;
+            }
+            throw std::system_error ( errno,
+                                      std::generic_category ( ),
+                                      "getrandom" );
+        }
+        done += std::size_t ( got );
+    }
+#elif defined( DARWIN )
+    // getentropy takes at most 256 bytes a call.
+    while ( done < count )
+    {
+        std::size_t const part = std::min< std::size_t > ( count - done, 256 );
+        if ( getentropy ( start + done, part ) != 0 )
+        {
+            throw std::system_error ( errno,
+                                      std::generic_category ( ),
+                                      "getentropy" );
+        }
+        done += part;
+    }
+#else
+    static bcrypt_library const library;
+    // the count is a ULONG.
+    while ( done < count )
+    {
+        ULONG const part = ULONG (
+                std::min< std::size_t > ( count - done, ULONG ( -1 ) ) );
+        if ( BCryptGenRandom ( NULL,
+                               start + done,
+                               part,
+                               BCRYPT_USE_SYSTEM_PREFERRED_RNG )
+             != 0 )
+        {
+            throw std::system_error ( 0,
+                                      std::generic_category ( ),
+                                      "BCryptGenRandom" );
+        }
+        done += part;
+    }
+#endif
+}
+
+entropy::buffer::buffer ( std::size_t const batch ) :
+        bytes ( batch ), used { batch }
+{ }
+
+void entropy::buffer::take ( std::uint8_t *const start,
+                             std::size_t const   count )
+{
+    if ( count >= bytes.size ( ) )
+    {
+        fill ( start, count );
+        return;
+    }
+    std::size_t done = 0;
+    while ( done < count )
+    {
+        if ( used == bytes.size ( ) )
+        {
+            fill ( bytes.data ( ), bytes.size ( ) );
+            used = 0;
+        }
+        std::size_t const part =
+                std::min ( count - done, bytes.size ( ) - used );
+        std::memcpy ( start + done, bytes.data ( ) + used, part );
+        used += part;
+        done += part;
+    }
+}
+
+namespace
+{
+    /**
+     * @brief The per-thread fixture of an entropy test: somewhere to put the
+     * bytes, and the thread's own buffer to take them from.
+     */
+    template < std::size_t request > class draw
+    {
+        std::vector< std::uint8_t > destination;
+        entropy::buffer             source;
+    public:
+        draw ( ) : destination ( request ) { }
+
+        void operator( ) ( )
+        {
+            source.take ( destination.data ( ), request );
+            keep_result ( destination [ 0 ] );
+        }
+    };
+
+    template < std::size_t request > individual_test draw_test ( )
+    {
+        individual_test result = fixture_test< draw< request > > (
+                "test.entropy." + std::to_string ( request ) );
+        result.bytes = request;
+        return result;
+    }
+} // namespace
+
+test_suite entropy::suite ( )
+{
+    return {
+            draw_test< key_bytes > ( ),
+            draw_test< 256 > ( ),
+            draw_test< std::size_t ( 2 ) << 10 > ( ),
+            draw_test< std::size_t ( 16 ) << 10 > ( ),
+            draw_test< std::size_t ( 128 ) << 10 > ( ),
+            draw_test< std::size_t ( 1 ) << 20 > ( ),
+    };
+}
@@ -0,0 +1,58 @@
+/**
+ * @file entropy.hh
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Cryptographically secure random bytes straight from the operating
+ * system: getrandom(2) on Linux, getentropy(2) on macOS and BCryptGenRandom
+ * on Windows, handed out from per-thread buffers filled in batches.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+#pragma once
+
+#include "test-suite.hh"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace markbench::entropy
+{
+    // an AES-256 key, the request test.crypto_safe_random makes.
+    inline constexpr std::size_t key_bytes = 256 / 8;
+
+    // how many bytes a buffer asks the operating system for at once.
+    inline constexpr std::size_t default_batch = std::size_t ( 64 ) << 10;
+
+    /**
+     * @brief Fills count bytes straight from the operating system's CSPRNG,
+     * in as few calls as it allows. Throws std::system_error if it fails.
+     */
+    void fill ( std::uint8_t *const start, std::size_t const count );
+
+    /**
+     * @brief Random bytes for one thread. Requests smaller than the batch
+     * are served from the bytes left over from the last fill, so a 32 byte
+     * key costs a copy and not a system call. Bigger requests go straight to
+     * fill. Every byte is handed out only once.
+     */
+    class buffer
+    {
+        std::vector< std::uint8_t > bytes;
+        // how many bytes at the front of bytes are already handed out.
+        std::size_t                 used;
+    public:
+        explicit buffer ( std::size_t const batch = default_batch );
+
+        void take ( std::uint8_t *const start, std::size_t const count );
+    };
+
+    /**
+     * @brief Tests of requests from a key's 32 bytes up to 1 MiB blocks, each
+     * through its thread's own buffer, named test.entropy.<bytes>.
+     */
+    test_suite suite ( );
+} // namespace markbench::entropy
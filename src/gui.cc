@@ -0,0 +1,106 @@
+/**
+ * @file gui.cc
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Loads GTK at run time instead of linking it.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+
+#include "gui.hh"
+
+#if defined( LINUX ) || defined( DARWIN )
+#    include <dlfcn.h>
+#endif
+
+namespace gui = markbench::gui;
+
+#if defined( LINUX ) || defined( DARWIN )
+
+namespace
+{
+    // the parts of GTK 3 that we use, declared here so that building does not
+    // need its headers either. GtkWidget is opaque to us anyway.
+    using init_check_function     = int ( * ) ( int *, char *** );
+    using window_new_function     = void *( * ) ( int );
+    using widget_destroy_function = void ( * ) ( void * );
+    // GTK_WINDOW_TOPLEVEL
+    constexpr int toplevel_window = 0;
+
+#    if defined( DARWIN )
+    constexpr char const *library_name = "libgtk-3.0.dylib";
+#    else
+    constexpr char const *library_name = "libgtk-3.so.0";
+#    endif
+
+    struct toolkit
+    {
+        std::string             unavailable;
+        window_new_function     window_new     = nullptr;
+        widget_destroy_function widget_destroy = nullptr;
+    };
+
+    toolkit load ( )
+    {
+        toolkit result;
+        void   *library = dlopen ( library_name, RTLD_NOW | RTLD_LOCAL );
+        if ( !library )
+        {
+            result.unavailable = std::string ( library_name )
+                               + " could not be loaded";
+            return result;
+        }
+        auto const init_check = reinterpret_cast< init_check_function > (
+                dlsym ( library, "gtk_init_check" ) );
+        result.window_new     = reinterpret_cast< window_new_function > (
+                dlsym ( library, "gtk_window_new" ) );
+        result.widget_destroy = reinterpret_cast< widget_destroy_function > (
+                dlsym ( library, "gtk_widget_destroy" ) );
+        if ( !init_check || !result.window_new || !result.widget_destroy )
+        {
+            result.unavailable = std::string ( library_name )
+                               + " is not GTK 3";
+            return result;
+        }
+        // unlike gtk_init, this returns false instead of exiting when there
+        // is no display to open.
+        if ( !init_check ( nullptr, nullptr ) )
+        {
+            result.unavailable = "there is no display";
+        }
+        // never unloaded: GTK does not support being initialized twice.
+        return result;
+    }
+
+    toolkit const &loaded ( )
+    {
+        static toolkit const result = load ( );
+        return result;
+    }
+} // namespace
+
+std::string const &gui::unavailable ( ) { return loaded ( ).unavailable; }
+
+void *gui::create_window ( )
+{
+    return loaded ( ).window_new ( toplevel_window );
+}
+
+void gui::destroy_window ( void *const window )
+{
+    loaded ( ).widget_destroy ( window );
+}
+
+#else
+
+std::string const &gui::unavailable ( )
+{
+    // Windows always has its windowing system.
+    static std::string const result;
+    return result;
+}
+
+#endif
@@ -0,0 +1,36 @@
+/**
+ * @file gui.hh
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief The windowing toolkit, loaded only when a test needs it.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+#pragma once
+
+#include <string>
+
+namespace markbench::gui
+{
+    /**
+     * @brief Why this machine cannot make windows, or empty if it can.
+     * @details On Linux and Mac OS, the first call loads GTK and opens the
+     * display, so that nothing pays for GTK unless a test uses it and a
+     * machine without GTK or without a display can still run everything else.
+     * Call it from the main thread before any thread makes a window.
+     */
+    std::string const &unavailable ( );
+
+#if defined( LINUX ) || defined( DARWIN )
+    /**
+     * @brief A new top-level GTK window, or nullptr. Only after unavailable
+     * came back empty. GTK is not thread-safe, so callers take turns.
+     */
+    void *create_window ( );
+
+    void destroy_window ( void *const window );
+#endif
+} // namespace markbench::gui
@@ -0,0 +1,731 @@
+/**
+ * @file hashing.cc
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief The hashes, their test vectors, and the tests.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+
+#include "hashing.hh"
+#include "cpu-features.hh"
+#include "entropy.hh"
+#include "test-utils.hh"
+
+#if defined( __x86_64__ )
+#    include <immintrin.h>
+#endif
+
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace hashing = markbench::hashing;
+
+namespace
+{
+    constexpr std::size_t sha256_block = 64;
+
+    constexpr std::array< std::uint32_t, 64 > round_constants {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b,
+            0x59f111f1, 0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01,
+            0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7,
+            0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+            0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152,
+            0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+            0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc,
+            0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819,
+            0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116, 0x1e376c08,
+            0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f,
+            0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+            0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+    };
+
+    using sha256_state = std::array< std::uint32_t, 8 >;
+
+    constexpr sha256_state sha256_initial {
+            0x6a09e667,
+            0xbb67ae85,
+            0x3c6ef372,
+            0xa54ff53a,
+            0x510e527f,
+            0x9b05688c,
+            0x1f83d9ab,
+            0x5be0cd19,
+    };
+
+    constexpr std::uint32_t rotate ( std::uint32_t const w, unsigned const n )
+    {
+        return ( w >> n ) | ( w << ( 32 - n ) );
+    }
+
+    inline std::uint32_t load_big ( std::uint8_t const *from )
+    {
+        return std::uint32_t ( from [ 0 ] ) << 24
+             | std::uint32_t ( from [ 1 ] ) << 16
+             | std::uint32_t ( from [ 2 ] ) << 8 | from [ 3 ];
+    }
+
+    inline std::uint32_t load_little ( std::uint8_t const *from )
+    {
+        return std::uint32_t ( from [ 3 ] ) << 24
+             | std::uint32_t ( from [ 2 ] ) << 16
+             | std::uint32_t ( from [ 1 ] ) << 8 | from [ 0 ];
+    }
+
+    namespace scalar
+    {
+        // FIPS 180-4 section 6.2.2, over every whole block.
+        void compress ( sha256_state       &h,
+                        std::uint8_t const *data,
+                        std::size_t const   blocks )
+        {
+            std::uint32_t w [ 64 ];
+            for ( std::size_t b = 0; b < blocks; b++ )
+            {
+                std::uint8_t const *const block = data + b * sha256_block;
+                for ( std::size_t t = 0; t < 16; t++ )
+                {
+                    w [ t ] = load_big ( block + 4 * t );
+                }
+                for ( std::size_t t = 16; t < 64; t++ )
+                {
+                    std::uint32_t const s0 = rotate ( w [ t - 15 ], 7 )
+                                           ^ rotate ( w [ t - 15 ], 18 )
+                                           ^ ( w [ t - 15 ] >> 3 );
+                    std::uint32_t const s1 = rotate ( w [ t - 2 ], 17 )
+                                           ^ rotate ( w [ t - 2 ], 19 )
+                                           ^ ( w [ t - 2 ] >> 10 );
+                    w [ t ] = w [ t - 16 ] + s0 + w [ t - 7 ] + s1;
+                }
+                std::uint32_t a = h [ 0 ], b_ = h [ 1 ], c = h [ 2 ],
+                              d = h [ 3 ], e = h [ 4 ], f = h [ 5 ],
+                              g = h [ 6 ], k = h [ 7 ];
+                for ( std::size_t t = 0; t < 64; t++ )
+                {
+                    std::uint32_t const s1 = rotate ( e, 6 ) ^ rotate ( e, 11 )
+                                           ^ rotate ( e, 25 );
+                    std::uint32_t const choose = ( e & f ) ^ ( ~e & g );
+                    std::uint32_t const t1 =
+                            k + s1 + choose + round_constants [ t ] + w [ t ];
+                    std::uint32_t const s0 = rotate ( a, 2 ) ^ rotate ( a, 13 )
+                                           ^ rotate ( a, 22 );
+                    std::uint32_t const majority =
+                            ( a & b_ ) ^ ( a & c ) ^ ( b_ & c );
+                    std::uint32_t const t2 = s0 + majority;
+                    k                      = g;
+                    g                      = f;
+                    f                      = e;
+                    e                      = d + t1;
+                    d                      = c;
+                    c                      = b_;
+                    b_                     = a;
+                    a                      = t1 + t2;
+                }
+                h [ 0 ] += a;
+                h [ 1 ] += b_;
+                h [ 2 ] += c;
+                h [ 3 ] += d;
+                h [ 4 ] += e;
+                h [ 5 ] += f;
+                h [ 6 ] += g;
+                h [ 7 ] += k;
+            }
+        }
+
+        // the reflected Castagnoli polynomial.
+        constexpr std::uint32_t castagnoli = 0x82f63b78;
+
+        using crc_tables = std::array< std::array< std::uint32_t, 256 >, 8 >;
+
+        /**
+         * @brief tables [ 0 ] is the usual byte at a time table. tables [ k ]
+         * is the CRC of a byte followed by k zero bytes, so that eight bytes
+         * can be looked up at once.
+         */
+        constexpr crc_tables make_crc_tables ( )
+        {
+            crc_tables result { };
+            for ( std::uint32_t b = 0; b < 256; b++ )
+            {
+                std::uint32_t crc = b;
+                for ( unsigned bit = 0; bit < 8; bit++ )
+                {
+                    crc = crc & 1 ? ( crc >> 1 ) ^ castagnoli : crc >> 1;
+                }
+                result [ 0 ][ b ] = crc;
+            }
+            for ( std::size_t k = 1; k < 8; k++ )
+            {
+                for ( std::size_t b = 0; b < 256; b++ )
+                {
+                    std::uint32_t const last = result [ k - 1 ][ b ];
+                    result [ k ][ b ] =
+                            ( last >> 8 ) ^ result [ 0 ][ last & 0xff ];
+                }
+            }
+            return result;
+        }
+
+        constexpr crc_tables tables = make_crc_tables ( );
+
+        // crc is the register: not inverted on the way in or out.
+        std::uint32_t crc32c ( std::uint32_t       crc,
+                               std::uint8_t const *data,
+                               std::size_t const   bytes )
+        {
+            std::size_t i = 0;
+            for ( ; i + 8 <= bytes; i += 8 )
+            {
+                std::uint32_t const low  = crc ^ load_little ( data + i );
+                std::uint32_t const high = load_little ( data + i + 4 );
+                crc = tables [ 7 ][ low & 0xff ]
+                    ^ tables [ 6 ][ ( low >> 8 ) & 0xff ]
+                    ^ tables [ 5 ][ ( low >> 16 ) & 0xff ]
+                    ^ tables [ 4 ][ low >> 24 ] ^ tables [ 3 ][ high & 0xff ]
+                    ^ tables [ 2 ][ ( high >> 8 ) & 0xff ]
+                    ^ tables [ 1 ][ ( high >> 16 ) & 0xff ]
+                    ^ tables [ 0 ][ high >> 24 ];
+            }
+            for ( ; i < bytes; i++ )
+            {
+                crc = ( crc >> 8 )
+                    ^ tables [ 0 ][ ( crc ^ data [ i ] ) & 0xff ];
+            }
+            return crc;
+        }
+    } // namespace scalar
+} // namespace
+
+#if defined( __x86_64__ )
+#    pragma GCC push_options
+#    pragma GCC target( "sha,ssse3,sse4.1" )
+namespace
+{
+    namespace shani
+    {
+        /**
+         * @brief The same rounds as scalar::compress, four at a time. The
+         * instructions want the state as ABEF and CDGH, not ABCD and EFGH.
+         */
+        void compress ( sha256_state       &h,
+                        std::uint8_t const *data,
+                        std::size_t const   blocks )
+        {
+            // each 32-bit word big-endian.
+            __m128i const byte_order = _mm_set_epi64x ( 0x0c0d0e0f08090a0b,
+                                                        0x0405060700010203 );
+
+            __m128i swapped = _mm_loadu_si128 (
+                    reinterpret_cast< __m128i const * > ( &h [ 0 ] ) );
+            __m128i state1 = _mm_loadu_si128 (
+                    reinterpret_cast< __m128i const * > ( &h [ 4 ] ) );
+            swapped        = _mm_shuffle_epi32 ( swapped, 0xb1 );
+            state1         = _mm_shuffle_epi32 ( state1, 0x1b );
+            __m128i state0 = _mm_alignr_epi8 ( swapped, state1, 8 );
+            state1         = _mm_blend_epi16 ( state1, swapped, 0xf0 );
+
+            for ( std::size_t b = 0; b < blocks; b++ )
+            {
+                std::uint8_t const *const block = data + b * sha256_block;
+                __m128i const             abef  = state0;
+                __m128i const             cdgh  = state1;
+                __m128i                   message [ 4 ];
+                // sixteen groups of four rounds. Each group also works on
+                // the message schedule of the groups to come.
+#    pragma GCC unroll 16
+                for ( std::size_t g = 0; g < 16; g++ )
+                {
+                    if ( g < 4 )
+                    {
+                        message [ g ] = _mm_shuffle_epi8 (
+                                _mm_loadu_si128 (
+                                        reinterpret_cast< __m128i const * > (
+                                                block + 16 * g ) ),
+                                byte_order );
+                    }
+                    __m128i words = _mm_add_epi32 (
+                            message [ g % 4 ],
+                            _mm_loadu_si128 (
+                                    reinterpret_cast< __m128i const * > (
+                                            &round_constants [ 4 * g ] ) ) );
+                    state1 = _mm_sha256rnds2_epu32 ( state1, state0, words );
+                    if ( g >= 3 && g < 15 )
+                    {
+                        __m128i &next = message [ ( g + 1 ) % 4 ];
+                        next          = _mm_add_epi32 (
+                                next,
+                                _mm_alignr_epi8 ( message [ g % 4 ],
+                                                  message [ ( g + 3 ) % 4 ],
+                                                  4 ) );
+                        next = _mm_sha256msg2_epu32 ( next, message [ g % 4 ] );
+                    }
+                    words  = _mm_shuffle_epi32 ( words, 0x0e );
+                    state0 = _mm_sha256rnds2_epu32 ( state0, state1, words );
+                    if ( g >= 1 && g < 13 )
+                    {
+                        __m128i &last = message [ ( g + 3 ) % 4 ];
+                        last = _mm_sha256msg1_epu32 ( last, message [ g % 4 ] );
+                    }
+                }
+                state0 = _mm_add_epi32 ( state0, abef );
+                state1 = _mm_add_epi32 ( state1, cdgh );
+            }
+
+            swapped = _mm_shuffle_epi32 ( state0, 0x1b );
+            state1  = _mm_shuffle_epi32 ( state1, 0xb1 );
+            state0  = _mm_blend_epi16 ( swapped, state1, 0xf0 );
+            state1  = _mm_alignr_epi8 ( state1, swapped, 8 );
+            _mm_storeu_si128 ( reinterpret_cast< __m128i * > ( &h [ 0 ] ),
+                               state0 );
+            _mm_storeu_si128 ( reinterpret_cast< __m128i * > ( &h [ 4 ] ),
+                               state1 );
+        }
+    } // namespace shani
+} // namespace
+#    pragma GCC pop_options
+
+#    pragma GCC push_options
+#    pragma GCC target( "sse4.2" )
+namespace
+{
+    namespace sse42
+    {
+        std::uint32_t crc32c ( std::uint32_t       crc,
+                               std::uint8_t const *data,
+                               std::size_t const   bytes )
+        {
+            std::uint64_t wide = crc;
+            std::size_t   i    = 0;
+            for ( ; i + 8 <= bytes; i += 8 )
+            {
+                std::uint64_t word;
+                std::memcpy ( &word, data + i, sizeof ( word ) );
+                wide = _mm_crc32_u64 ( wide, word );
+            }
+            crc = std::uint32_t ( wide );
+            for ( ; i < bytes; i++ ) { crc = _mm_crc32_u8 ( crc, data [ i ] ); }
+            return crc;
+        }
+    } // namespace sse42
+} // namespace
+#    pragma GCC pop_options
+
+#    pragma GCC push_options
+#    pragma GCC target( "pclmul,sse4.2" )
+namespace
+{
+    namespace pclmul
+    {
+        /**
+         * @brief x^n mod P, bit-reflected into the top half of 64 bits, which
+         * is how pclmulqdq has to see a constant to multiply reflected data
+         * by x^(n + 1).
+         */
+        std::uint64_t fold_constant ( unsigned const n )
+        {
+            // P, not reflected, with its x^32.
+            constexpr std::uint64_t polynomial = 0x11edc6f41;
+            std::uint64_t           remainder  = 1;
+            for ( unsigned i = 0; i < n; i++ )
+            {
+                remainder <<= 1;
+                if ( remainder >> 32 )
+                {
+                    remainder ^= polynomial;
+                }
+            }
+            std::uint64_t result = 0;
+            for ( unsigned bit = 0; bit < 32; bit++ )
+            {
+                if ( remainder >> bit & 1 )
+                {
+                    result |= std::uint64_t ( 1 ) << ( 63 - bit );
+                }
+            }
+            return result;
+        }
+
+        /**
+         * @brief Moves the 128 bits of x forward by the distance the
+         * constants were made for: the low half by x^(distance + 64) and the
+         * high half by x^distance, mod P.
+         */
+        inline __m128i fold ( __m128i const x, __m128i const constants )
+        {
+            return _mm_xor_si128 (
+                    _mm_clmulepi64_si128 ( x, constants, 0x00 ),
+                    _mm_clmulepi64_si128 ( x, constants, 0x11 ) );
+        }
+
+        inline __m128i constants_for ( unsigned const distance )
+        {
+            return _mm_set_epi64x ( fold_constant ( distance - 1 ),
+                                    fold_constant ( distance + 64 - 1 ) );
+        }
+
+        /**
+         * @brief Four lanes of 128 bits, each folded 512 bits forward onto
+         * the next 64 bytes, then folded into one and finished with crc32.
+         */
+        std::uint32_t crc32c ( std::uint32_t       crc,
+                               std::uint8_t const *data,
+                               std::size_t const   bytes )
+        {
+            if ( bytes < 128 )
+            {
+                return sse42::crc32c ( crc, data, bytes );
+            }
+            static __m128i const by_512 = constants_for ( 512 );
+            static __m128i const by_128 = constants_for ( 128 );
+            auto const           load   = [ & ] ( std::size_t const at ) {
+                return _mm_loadu_si128 (
+                        reinterpret_cast< __m128i const * > ( data + at ) );
+            };
+
+            __m128i lanes [ 4 ];
+            for ( std::size_t j = 0; j < 4; j++ )
+            {
+                lanes [ j ] = load ( 16 * j );
+            }
+            // the register starts as part of the first bytes.
+            lanes [ 0 ] = _mm_xor_si128 ( lanes [ 0 ],
+                                          _mm_cvtsi32_si128 ( int ( crc ) ) );
+            std::size_t i = 64;
+            for ( ; i + 64 <= bytes; i += 64 )
+            {
+#    pragma GCC unroll 4
+                for ( std::size_t j = 0; j < 4; j++ )
+                {
+                    lanes [ j ] = _mm_xor_si128 ( fold ( lanes [ j ], by_512 ),
+                                                  load ( i + 16 * j ) );
+                }
+            }
+            __m128i folded = lanes [ 0 ];
+            for ( std::size_t j = 1; j < 4; j++ )
+            {
+                folded = _mm_xor_si128 ( fold ( folded, by_128 ), lanes [ j ] );
+            }
+            // what is left is congruent to the message, so crc32 from zero
+            // over it gives the register.
+            std::uint64_t wide = 0;
+            wide = _mm_crc32_u64 ( wide, _mm_cvtsi128_si64 ( folded ) );
+            wide = _mm_crc32_u64 ( wide, _mm_extract_epi64 ( folded, 1 ) );
+            return sse42::crc32c (
+                    std::uint32_t ( wide ), data + i, bytes - i );
+        }
+    } // namespace pclmul
+} // namespace
+#    pragma GCC pop_options
+#endif
+
+std::string hashing::path_name ( sha256_path const p )
+{
+    switch ( p )
+    {
+        case sha256_path::scalar: return "scalar";
+        case sha256_path::shani: return "shani";
+        default: return "?";
+    }
+}
+
+std::string hashing::path_name ( crc32c_path const p )
+{
+    switch ( p )
+    {
+        case crc32c_path::scalar: return "scalar";
+        case crc32c_path::sse42: return "sse42";
+        case crc32c_path::pclmul: return "pclmul";
+        default: return "?";
+    }
+}
+
+hashing::digest hashing::sha256 ( sha256_path const   p,
+                                  std::uint8_t const *data,
+                                  std::size_t const   bytes )
+{
+    auto const compress = [ p ] ( sha256_state       &h,
+                                  std::uint8_t const *from,
+                                  std::size_t const   blocks ) {
+        switch ( p )
+        {
+#if defined( __x86_64__ )
+            case sha256_path::shani:
+                shani::compress ( h, from, blocks );
+                break;
+#endif
+            default: scalar::compress ( h, from, blocks ); break;
+        }
+    };
+
+    sha256_state      h      = sha256_initial;
+    std::size_t const blocks = bytes / sha256_block;
+    compress ( h, data, blocks );
+
+    // the rest, a one bit, zeros, and the length in bits, big-endian, which
+    // takes one block or two.
+    std::array< std::uint8_t, 2 * sha256_block > last { };
+    std::size_t const rest = bytes - blocks * sha256_block;
+    std::memcpy ( last.data ( ), data + blocks * sha256_block, rest );
+    last [ rest ]            = 0x80;
+    std::size_t const tail   = rest + 9 > sha256_block ? 2 : 1;
+    std::uint64_t const bits = std::uint64_t ( bytes ) * 8;
+    for ( std::size_t n = 0; n < 8; n++ )
+    {
+        last [ tail * sha256_block - 1 - n ] = std::uint8_t ( bits >> 8 * n );
+    }
+    compress ( h, last.data ( ), tail );
+
+    digest result;
+    for ( std::size_t n = 0; n < h.size ( ); n++ )
+    {
+        for ( std::size_t b = 0; b < 4; b++ )
+        {
+            result [ 4 * n + b ] = std::uint8_t ( h [ n ] >> ( 24 - 8 * b ) );
+        }
+    }
+    return result;
+}
+
+std::uint32_t hashing::crc32c ( crc32c_path const   p,
+                                std::uint8_t const *data,
+                                std::size_t const   bytes,
+                                std::uint32_t const crc )
+{
+    // the register starts inverted and the result is inverted back, so that
+    // carrying on from a CRC is the same as never having stopped.
+    switch ( p )
+    {
+#if defined( __x86_64__ )
+        case crc32c_path::sse42: return ~sse42::crc32c ( ~crc, data, bytes );
+        case crc32c_path::pclmul: return ~pclmul::crc32c ( ~crc, data, bytes );
+#endif
+        default: return ~scalar::crc32c ( ~crc, data, bytes );
+    }
+}
+
+namespace
+{
+    std::string hex ( hashing::digest const &d )
+    {
+        constexpr char digits [] = "0123456789abcdef";
+        std::string    result;
+        for ( std::uint8_t const b : d )
+        {
+            result += digits [ b >> 4 ];
+            result += digits [ b & 15 ];
+        }
+        return result;
+    }
+
+    // enough for every loop, in every path, with a tail after it.
+    std::vector< std::uint8_t > long_message ( )
+    {
+        std::vector< std::uint8_t > result ( 4099 );
+        for ( std::size_t i = 0; i < result.size ( ); i++ )
+        {
+            result [ i ] = std::uint8_t ( i * 131 + ( i >> 8 ) );
+        }
+        return result;
+    }
+
+    /**
+     * @brief Whether the path gets the digests of FIPS 180-4's examples, for
+     * no bytes, one block and the 56 bytes that need a second, and agrees
+     * with the scalar path on a longer message.
+     */
+    bool known_answers ( hashing::sha256_path const p )
+    {
+        auto const of = [ p ] ( std::string const &text ) {
+            return hex ( hashing::sha256 (
+                    p,
+                    reinterpret_cast< std::uint8_t const * > ( text.data ( ) ),
+                    text.size ( ) ) );
+        };
+        if ( of ( "" )
+                     != "e3b0c44298fc1c149afbf4c8996fb924"
+                        "27ae41e4649b934ca495991b7852b855"
+             || of ( "abc" )
+                        != "ba7816bf8f01cfea414140de5dae2223"
+                           "b00361a396177a9cb410ff61f20015ad"
+             || of ( "abcdbcdecdefdefgefghfghighijhijk"
+                     "ijkljklmklmnlmnomnopnopq" )
+                        != "248d6a61d20638b8e5c026930c3e6039"
+                           "a33ce45964ff2167f6ecedd419db06c1" )
+        {
+            return false;
+        }
+        auto const message = long_message ( );
+        return hashing::sha256 ( p, message.data ( ), message.size ( ) )
+            == hashing::sha256 ( hashing::sha256_path::scalar,
+                                 message.data ( ),
+                                 message.size ( ) );
+    }
+
+    /**
+     * @brief Whether the path gets the check value of CRC32C and the examples
+     * of RFC 3720 appendix B.4, and agrees with the scalar path on a longer
+     * message, whole and in two parts.
+     */
+    bool known_answers ( hashing::crc32c_path const p )
+    {
+        std::string const check = "123456789";
+        if ( hashing::crc32c ( p,
+                               reinterpret_cast< std::uint8_t const * > (
+                                       check.data ( ) ),
+                               check.size ( ) )
+             != 0xe3069283 )
+        {
+            return false;
+        }
+        std::array< std::uint8_t, 32 > zeros { };
+        std::array< std::uint8_t, 32 > ones;
+        std::array< std::uint8_t, 32 > ascending;
+        for ( std::size_t i = 0; i < 32; i++ )
+        {
+            ones [ i ]      = 0xff;
+            ascending [ i ] = std::uint8_t ( i );
+        }
+        auto const of = [ p ] ( std::array< std::uint8_t, 32 > const &a ) {
+            return hashing::crc32c ( p, a.data ( ), a.size ( ) );
+        };
+        if ( of ( zeros ) != 0x8a9136aa || of ( ones ) != 0x62a8ab43
+             || of ( ascending ) != 0x46dd794e )
+        {
+            return false;
+        }
+        auto const          message = long_message ( );
+        std::size_t const   half    = message.size ( ) / 2;
+        std::uint32_t const expected =
+                hashing::crc32c ( hashing::crc32c_path::scalar,
+                                  message.data ( ),
+                                  message.size ( ) );
+        return hashing::crc32c ( p, message.data ( ), message.size ( ) )
+                    == expected
+            && hashing::crc32c ( p,
+                                 message.data ( ) + half,
+                                 message.size ( ) - half,
+                                 hashing::crc32c ( p, message.data ( ), half ) )
+                       == expected;
+    }
+} // namespace
+
+std::string const &hashing::unavailable ( sha256_path const p )
+{
+    static std::string const none;
+    static std::string const failed [] = {
+            "the scalar SHA-256 path fails its test vectors",
+            "the SHA-NI path fails its test vectors",
+    };
+    static bool const passed [] = {
+            known_answers ( sha256_path::scalar ),
+            markbench::cpu::needs_sha ( ).empty ( )
+                    && known_answers ( sha256_path::shani ),
+    };
+    if ( p == sha256_path::shani && !markbench::cpu::needs_sha ( ).empty ( ) )
+    {
+        return markbench::cpu::needs_sha ( );
+    }
+    return passed [ unsigned ( p ) ] ? none : failed [ unsigned ( p ) ];
+}
+
+std::string const &hashing::unavailable ( crc32c_path const p )
+{
+    static std::string const none;
+    static std::string const failed [] = {
+            "the scalar CRC32C path fails its test vectors",
+            "the SSE4.2 CRC32C path fails its test vectors",
+            "the PCLMULQDQ CRC32C path fails its test vectors",
+    };
+    static bool const passed [] = {
+            known_answers ( crc32c_path::scalar ),
+            markbench::cpu::needs_sse4_2 ( ).empty ( )
+                    && known_answers ( crc32c_path::sse42 ),
+            markbench::cpu::needs_pclmul ( ).empty ( )
+                    && known_answers ( crc32c_path::pclmul ),
+    };
+    switch ( p )
+    {
+        case crc32c_path::sse42:
+            if ( !markbench::cpu::needs_sse4_2 ( ).empty ( ) )
+            {
+                return markbench::cpu::needs_sse4_2 ( );
+            }
+            break;
+        case crc32c_path::pclmul:
+            if ( !markbench::cpu::needs_pclmul ( ).empty ( ) )
+            {
+                return markbench::cpu::needs_pclmul ( );
+            }
+            break;
+        default: break;
+    }
+    return passed [ unsigned ( p ) ] ? none : failed [ unsigned ( p ) ];
+}
+
+namespace
+{
+    /**
+     * @brief The per-thread fixture of a hashing test: a buffer of random
+     * bytes, which every iteration hashes whole.
+     */
+    template < typename path, path p, std::size_t bytes > class hash
+    {
+        std::vector< std::uint8_t > buffer;
+    public:
+        hash ( ) : buffer ( bytes )
+        {
+            markbench::entropy::fill ( buffer.data ( ), buffer.size ( ) );
+        }
+
+        void operator( ) ( )
+        {
+            if constexpr ( std::is_same_v< path, hashing::sha256_path > )
+            {
+                keep_result ( hashing::sha256 ( p, buffer.data ( ), bytes ) );
+            } else
+            {
+                keep_result ( hashing::crc32c ( p, buffer.data ( ), bytes ) );
+            }
+        }
+    };
+
+    template < typename path, path p, std::size_t bytes >
+    individual_test hash_test ( )
+    {
+        constexpr bool    sha256 = std::is_same_v< path, hashing::sha256_path >;
+        std::string const kind   = sha256 ? "sha256" : "crc32c";
+        individual_test   result = fixture_test< hash< path, p, bytes > > (
+                "test.hash." + kind + "." + hashing::path_name ( p ) + "."
+                + std::to_string ( bytes ) );
+        result.unavailable = [] ( ) -> std::string const & {
+            return hashing::unavailable ( p );
+        };
+        result.bytes = bytes;
+        return result;
+    }
+
+    template < typename path, path p > void add_sizes ( test_suite &suite )
+    {
+        constexpr std::size_t kibibyte = 1024;
+        suite.push_back ( hash_test< path, p, 64 > ( ) );
+        suite.push_back ( hash_test< path, p, kibibyte > ( ) );
+        suite.push_back ( hash_test< path, p, 16 * kibibyte > ( ) );
+        suite.push_back ( hash_test< path, p, kibibyte * kibibyte > ( ) );
+    }
+} // namespace
+
+test_suite hashing::suite ( )
+{
+    test_suite result;
+    add_sizes< sha256_path, sha256_path::scalar > ( result );
+    add_sizes< sha256_path, sha256_path::shani > ( result );
+    add_sizes< crc32c_path, crc32c_path::scalar > ( result );
+    add_sizes< crc32c_path, crc32c_path::sse42 > ( result );
+    add_sizes< crc32c_path, crc32c_path::pclmul > ( result );
+    return result;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file hashing.hh
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief SHA-256 and CRC32C, each in portable code and with the instructions
+ * made for it, picked when the processor has them.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+#pragma once
+
+#include "test-suite.hh"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace markbench::hashing
+{
+    using digest = std::array< std::uint8_t, 32 >;
+
+    enum class sha256_path
+    {
+        // the rounds as FIPS 180-4 writes them.
+        scalar,
+        // sha256rnds2, sha256msg1 and sha256msg2.
+        shani,
+    };
+
+    enum class crc32c_path
+    {
+        // eight bytes at a time, through eight tables.
+        scalar,
+        // the SSE4.2 crc32 instruction, eight bytes at a time.
+        sse42,
+        // pclmulqdq folding 64 bytes at a time, and crc32 for what is left.
+        pclmul,
+    };
+
+    // "scalar", "shani", "sse42" or "pclmul".
+    std::string path_name ( sha256_path const p );
+    std::string path_name ( crc32c_path const p );
+
+    /**
+     * @brief Why the path cannot run here, or empty if it can. A path that
+     * the processor has but that gets a test vector wrong, or disagrees with
+     * the scalar path, cannot run either.
+     */
+    std::string const &unavailable ( sha256_path const p );
+    std::string const &unavailable ( crc32c_path const p );
+
+    digest sha256 ( sha256_path const   p,
+                    std::uint8_t const *data,
+                    std::size_t const   bytes );
+
+    /**
+     * @brief The CRC32C (Castagnoli) of the bytes, carrying on from crc, the
+     * CRC of whatever came before them.
+     */
+    std::uint32_t crc32c ( crc32c_path const   p,
+                           std::uint8_t const *data,
+                           std::size_t const   bytes,
+                           std::uint32_t const crc = 0 );
+
+    /**
+     * @brief Hashes of buffers of random bytes from 64 B to 1 MiB, named
+     * test.hash.<sha256|crc32c>.<path>.<bytes>.
+     */
+    test_suite suite ( );
+} // namespace markbench::hashing
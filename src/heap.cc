@@ -0,0 +1,410 @@
+/**
+ * @file heap.cc
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief The allocation patterns and the allocators they run through.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+
+#include "heap.hh"
+#include "test-utils.hh"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace heap = markbench::heap;
+
+namespace
+{
+    enum class allocator
+    {
+        malloc,
+        pool,
+        arena,
+        shared_pool,
+    };
+
+    std::string allocator_name ( allocator const a )
+    {
+        switch ( a )
+        {
+            case allocator::malloc: return "malloc";
+            case allocator::pool: return "pool";
+            case allocator::arena: return "arena";
+            case allocator::shared_pool: return "shared_pool";
+            default: return "?";
+        }
+    }
+
+    constexpr std::size_t alignment = alignof ( std::max_align_t );
+
+    /**
+     * @brief How often a program asks for a block of up to each size, in
+     * hundredths of a percent. Most blocks are a few dozen bytes, as in the
+     * allocation profiles of long-running services, with a thin tail of
+     * buffers up to 64 KiB.
+     */
+    struct size_class
+    {
+        std::size_t bytes;
+        unsigned    weight;
+    };
+
+    constexpr std::array< size_class, 12 > size_classes { {
+            { 16, 2400 },
+            { 32, 2200 },
+            { 48, 1200 },
+            { 64, 1200 },
+            { 96, 800 },
+            { 128, 700 },
+            { 256, 600 },
+            { 512, 400 },
+            { 1024, 250 },
+            { 4096, 150 },
+            { 16384, 80 },
+            { 65536, 20 },
+    } };
+
+    /**
+     * @brief The sizes a thread allocates, drawn from the size classes and
+     * spread evenly within each one, so that a size class allocator sees
+     * sizes that do not all fall on its boundaries. Made before the test
+     * starts, since the random numbers are not what is measured.
+     */
+    std::vector< std::size_t > size_mix ( std::size_t const count,
+                                          rng::result_type const seed )
+    {
+        std::vector< unsigned > weights;
+        for ( auto const &c : size_classes ) { weights.push_back ( c.weight ); }
+        rng                                       random { seed };
+        std::discrete_distribution< std::size_t > pick { weights.begin ( ),
+                                                         weights.end ( ) };
+        std::vector< std::size_t >                result;
+        for ( std::size_t i = 0; i < count; i++ )
+        {
+            std::size_t const c     = pick ( random );
+            std::size_t const above = c == 0 ? 0 : size_classes [ c - 1 ].bytes;
+            std::uniform_int_distribution< std::size_t > within {
+                    above + 1, size_classes [ c ].bytes };
+            result.push_back ( within ( random ) );
+        }
+        return result;
+    }
+
+    struct block
+    {
+        void       *pointer;
+        std::size_t bytes;
+    };
+
+    /**
+     * @brief The thread's own memory resource for the allocators that have
+     * one.
+     */
+    class local_resource
+    {
+        std::optional< std::pmr::unsynchronized_pool_resource > pool;
+        // enough for any iteration's blocks but the rarest, which spill over
+        // into operator new.
+        std::vector< std::byte >                                buffer;
+        std::optional< std::pmr::monotonic_buffer_resource >    arena;
+        std::pmr::memory_resource                              *active;
+    public:
+        explicit local_resource ( allocator const a )
+        {
+            if ( a == allocator::pool )
+            {
+                active = &pool.emplace ( );
+            } else if ( a == allocator::arena )
+            {
+                buffer.resize ( std::size_t ( 1 ) << 20 );
+                active = &arena.emplace ( buffer.data ( ), buffer.size ( ) );
+            } else
+            {
+                active = std::pmr::new_delete_resource ( );
+            }
+        }
+
+        local_resource ( local_resource const & )            = delete;
+        local_resource &operator= ( local_resource const & ) = delete;
+
+        block allocate ( std::size_t const bytes )
+        {
+            block result { active->allocate ( bytes, alignment ), bytes };
+            // the program would use what it asked for.
+            *static_cast< char volatile * > ( result.pointer ) = 0;
+            return result;
+        }
+
+        void deallocate ( block const &b )
+        {
+            active->deallocate ( b.pointer, b.bytes, alignment );
+        }
+
+        // the end of an arena's life, where all its blocks go at once.
+        void release ( )
+        {
+            if ( arena )
+            {
+                arena->release ( );
+            }
+        }
+    };
+
+    // how many sizes each thread cycles through.
+    constexpr std::size_t mix_length = 16 * heap::per_iteration;
+
+    /**
+     * @brief Allocates per_iteration blocks, then frees them, either newest
+     * first, as a stack of scopes does, or in an order that has nothing to
+     * do with the order they came in.
+     */
+    template < bool random_order, allocator a > class batches
+    {
+        local_resource             resource { a };
+        std::vector< std::size_t > sizes;
+        std::vector< std::size_t > order;
+        std::vector< block >       blocks;
+        std::size_t                next = 0;
+    public:
+        static constexpr char const *pattern = random_order ? "random"
+                                                            : "lifo";
+        static constexpr allocator   kind    = a;
+
+        explicit batches ( markbench::fixture_context const &context ) :
+                sizes { size_mix ( mix_length, context.thread + 1 ) },
+                order ( heap::per_iteration ),
+                blocks ( heap::per_iteration )
+        {
+            std::iota ( order.rbegin ( ), order.rend ( ), 0 );
+            if constexpr ( random_order )
+            {
+                rng random ( context.thread + 1 );
+                std::shuffle ( order.begin ( ), order.end ( ), random );
+            }
+        }
+
+        void operator( ) ( )
+        {
+            for ( std::size_t i = 0; i < heap::per_iteration; i++ )
+            {
+                blocks [ i ] = resource.allocate ( sizes [ next + i ] );
+            }
+            for ( std::size_t const i : order )
+            {
+                resource.deallocate ( blocks [ i ] );
+            }
+            resource.release ( );
+            next = ( next + heap::per_iteration ) % mix_length;
+        }
+    };
+
+    /**
+     * @brief A long-lived heap of blocks, of which each iteration replaces
+     * per_iteration picked at random with blocks of new sizes. Over the run
+     * the free space is cut up between blocks that stay, as it is in a
+     * program that runs for days.
+     */
+    template < allocator a > class churn
+    {
+        static constexpr std::size_t live_blocks = 64 * heap::per_iteration;
+
+        local_resource             resource { a };
+        std::vector< std::size_t > sizes;
+        std::vector< std::size_t > victims;
+        std::vector< block >       live;
+        std::size_t                next = 0;
+    public:
+        static constexpr char const *pattern = "churn";
+        static constexpr allocator   kind    = a;
+
+        explicit churn ( markbench::fixture_context const &context ) :
+                sizes { size_mix ( mix_length, context.thread + 1 ) },
+                victims ( mix_length )
+        {
+            rng random ( context.thread + 1 );
+            std::uniform_int_distribution< std::size_t > pick {
+                    0, live_blocks - 1 };
+            for ( auto &v : victims ) { v = pick ( random ); }
+            for ( std::size_t i = 0; i < live_blocks; i++ )
+            {
+                live.push_back (
+                        resource.allocate ( sizes [ i % mix_length ] ) );
+            }
+        }
+
+        ~churn ( )
+        {
+            for ( auto const &b : live ) { resource.deallocate ( b ); }
+        }
+
+        churn ( churn const & )            = delete;
+        churn &operator= ( churn const & ) = delete;
+
+        void operator( ) ( )
+        {
+            for ( std::size_t i = 0; i < heap::per_iteration; i++ )
+            {
+                block &victim = live [ victims [ next + i ] ];
+                resource.deallocate ( victim );
+                victim = resource.allocate ( sizes [ next + i ] );
+            }
+            next = ( next + heap::per_iteration ) % mix_length;
+        }
+    };
+
+    /**
+     * @brief Where the threads of a cross-thread test leave each other the
+     * blocks to free. Thread i sends to thread i + 1 and the last thread to
+     * the first, so with one thread the test frees its own blocks and is the
+     * baseline for the others. Shared by every thread of a run, and frees
+     * whatever is left once the last one is done with it.
+     */
+    class exchange
+    {
+        struct mailbox
+        {
+            std::mutex                          lock;
+            std::vector< std::vector< block > > batches;
+        };
+
+        std::optional< std::pmr::synchronized_pool_resource > pool;
+        std::unique_ptr< mailbox [] >                         mailboxes;
+    public:
+        markbench::thread_count const threads;
+        allocator const               kind;
+        std::pmr::memory_resource    *resource;
+
+        exchange ( markbench::thread_count const threads,
+                   allocator const               kind ) :
+                mailboxes { new mailbox [ threads ] },
+                threads { threads },
+                kind { kind }
+        {
+            resource = kind == allocator::shared_pool
+                             ? &pool.emplace ( )
+                             : std::pmr::new_delete_resource ( );
+        }
+
+        ~exchange ( )
+        {
+            for ( markbench::thread_count i = 0; i < threads; i++ )
+            {
+                for ( auto const &batch : mailboxes [ i ].batches )
+                {
+                    for ( auto const &b : batch )
+                    {
+                        resource->deallocate ( b.pointer, b.bytes, alignment );
+                    }
+                }
+            }
+        }
+
+        exchange ( exchange const & )            = delete;
+        exchange &operator= ( exchange const & ) = delete;
+
+        void send ( markbench::thread_count const from,
+                    std::vector< block >        &&batch )
+        {
+            mailbox          &to = mailboxes [ ( from + 1 ) % threads ];
+            std::scoped_lock  lock { to.lock };
+            to.batches.push_back ( std::move ( batch ) );
+        }
+
+        // everything sent to the thread so far.
+        std::vector< std::vector< block > >
+                receive ( markbench::thread_count const thread )
+        {
+            mailbox                            &box = mailboxes [ thread ];
+            std::vector< std::vector< block > > result;
+            std::scoped_lock                    lock { box.lock };
+            result.swap ( box.batches );
+            return result;
+        }
+    };
+
+    /**
+     * @brief Allocates per_iteration blocks and hands them to the next
+     * thread, then frees everything the previous thread handed over, as a
+     * producer and a consumer of messages would. The allocator has to be
+     * one that any thread can free into.
+     */
+    template < allocator a > class cross_thread
+    {
+        std::shared_ptr< exchange > shared;
+        markbench::thread_count     thread;
+        std::vector< std::size_t >  sizes;
+        std::size_t                 next = 0;
+    public:
+        static constexpr char const *pattern = "cross_thread";
+        static constexpr allocator   kind    = a;
+
+        explicit cross_thread ( markbench::fixture_context const &context ) :
+                shared { shared_per_pass< exchange > ( context.threads, a ) },
+                thread { context.thread },
+                sizes { size_mix ( mix_length, context.thread + 1 ) }
+        { }
+
+        void operator( ) ( )
+        {
+            std::pmr::memory_resource *const resource = shared->resource;
+            std::vector< block >             batch;
+            batch.reserve ( heap::per_iteration );
+            for ( std::size_t i = 0; i < heap::per_iteration; i++ )
+            {
+                std::size_t const bytes = sizes [ next + i ];
+                batch.push_back (
+                        { resource->allocate ( bytes, alignment ), bytes } );
+                *static_cast< char volatile * > ( batch.back ( ).pointer ) = 0;
+            }
+            shared->send ( thread, std::move ( batch ) );
+            for ( auto const &received : shared->receive ( thread ) )
+            {
+                for ( auto const &b : received )
+                {
+                    resource->deallocate ( b.pointer, b.bytes, alignment );
+                }
+            }
+            next = ( next + heap::per_iteration ) % mix_length;
+        }
+    };
+
+    // named after the fixture's own pattern and allocator, so that the name
+    // cannot disagree with what the test does.
+    template < typename fixture_type > individual_test heap_test ( )
+    {
+        return fixture_test< fixture_type > (
+                std::string ( "test.heap." ) + fixture_type::pattern + "."
+                + allocator_name ( fixture_type::kind ) );
+    }
+} // namespace
+
+test_suite heap::suite ( )
+{
+    return {
+            heap_test< batches< false, allocator::malloc > > ( ),
+            heap_test< batches< false, allocator::pool > > ( ),
+            heap_test< batches< false, allocator::arena > > ( ),
+            heap_test< batches< true, allocator::malloc > > ( ),
+            heap_test< batches< true, allocator::pool > > ( ),
+            heap_test< batches< true, allocator::arena > > ( ),
+            // an arena would only grow.
+            heap_test< churn< allocator::malloc > > ( ),
+            heap_test< churn< allocator::pool > > ( ),
+            // the per-thread resources cannot take another thread's blocks.
+            heap_test< cross_thread< allocator::malloc > > ( ),
+            heap_test< cross_thread< allocator::shared_pool > > ( ),
+    };
+}
@@ -0,0 +1,39 @@
+/**
+ * @file heap.hh
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Allocator stress tests: a realistic mix of small object sizes,
+ * freed in the order they came, in a random order, from another thread, or
+ * a few at a time out of a long-lived heap, through malloc and through the
+ * standard library's pool and arena memory resources.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+#pragma once
+
+#include "test-suite.hh"
+
+#include <cstddef>
+
+namespace markbench::heap
+{
+    /**
+     * @brief How many blocks one iteration of every heap test allocates and
+     * frees.
+     */
+    inline constexpr std::size_t per_iteration = 256;
+
+    /**
+     * @brief The tests, named test.heap.<pattern>.<allocator>. The patterns
+     * are lifo, random, churn and cross_thread. The allocators are malloc
+     * (through operator new), pool (a std::pmr::unsynchronized_pool_resource
+     * per thread), arena (a std::pmr::monotonic_buffer_resource per thread,
+     * released after every iteration) and shared_pool (one
+     * std::pmr::synchronized_pool_resource for every thread). Not every
+     * allocator can run every pattern.
+     */
+    test_suite suite ( );
+} // namespace markbench::heap
@@ -0,0 +1,245 @@
+/**
+ * @file host.cc
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Describes the machine markbench runs on.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+
+#include "host.hh"
+
+#include "isa-dispatch.hh"
+#include "timing.hh"
+#include "topology.hh"
+
+#if defined( LINUX ) || defined( DARWIN )
+#    include <sys/utsname.h>
+#    include <unistd.h>
+#elif defined( WINDOWS )
+#    ifndef UNICODE
+#        define UNICODE 1
+#    endif
+#    include "windows.h"
+#endif
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+#    include <cpuid.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <set>
+#include <sstream>
+
+namespace host = markbench::host;
+
+static std::string const unknown = "unknown";
+
+/**
+ * @brief The processor's brand string, straight from cpuid on x86 and from
+ * /proc/cpuinfo everywhere else that has it.
+ */
+static std::string cpu_model ( )
+{
+#if defined( __x86_64__ ) || defined( __i386__ )
+    unsigned highest = __get_cpuid_max ( 0x80000000, nullptr );
+    if ( highest >= 0x80000004 )
+    {
+        std::array< unsigned, 12 > brand { };
+        for ( unsigned i = 0; i < 3; i++ )
+        {
+            __get_cpuid ( 0x80000002 + i,
+                          &brand [ 4 * i ],
+                          &brand [ 4 * i + 1 ],
+                          &brand [ 4 * i + 2 ],
+                          &brand [ 4 * i + 3 ] );
+        }
+        char text [ sizeof ( brand ) + 1 ] = { };
+        std::memcpy ( text, brand.data ( ), sizeof ( brand ) );
+        std::string model = text;
+        // the brand string is padded with spaces on some processors.
+        model.erase ( 0, model.find_first_not_of ( ' ' ) );
+        model.erase ( model.find_last_not_of ( ' ' ) + 1 );
+        if ( !model.empty ( ) )
+        {
+            return model;
+        }
+    }
+#endif
+    std::ifstream cpuinfo { "/proc/cpuinfo" };
+    std::string   line;
+    while ( std::getline ( cpuinfo, line ) )
+    {
+        for ( auto const key : { "model name", "Model", "cpu model" } )
+        {
+            if ( line.rfind ( key, 0 ) == 0 )
+            {
+                std::size_t const colon = line.find ( ':' );
+                if ( colon != std::string::npos )
+                {
+                    return line.substr ( line.find_first_not_of ( " \t",
+                                                                  colon + 1 ) );
+                }
+            }
+        }
+    }
+    return unknown;
+}
+
+static std::string kernel ( )
+{
+#if defined( LINUX ) || defined( DARWIN )
+    utsname name;
+    if ( uname ( &name ) == 0 )
+    {
+        return std::string ( name.sysname ) + " " + name.release;
+    }
+#elif defined( WINDOWS )
+    return "Windows";
+#endif
+    return unknown;
+}
+
+static std::string hostname ( )
+{
+#if defined( LINUX ) || defined( DARWIN )
+    char name [ 256 ] = { };
+    if ( gethostname ( name, sizeof ( name ) - 1 ) == 0 )
+    {
+        return name;
+    }
+#elif defined( WINDOWS )
+    char  name [ MAX_COMPUTERNAME_LENGTH + 1 ] = { };
+    DWORD size                                  = sizeof ( name );
+    if ( GetComputerNameA ( name, &size ) )
+    {
+        return name;
+    }
+#endif
+    return unknown;
+}
+
+static std::string compiler ( )
+{
+#if defined( __clang__ )
+    return "clang " __clang_version__;
+#elif defined( __GNUC__ )
+    return "g++ " __VERSION__;
+#elif defined( _MSC_VER )
+    return "msvc " + std::to_string ( _MSC_VER );
+#else
+    return unknown;
+#endif
+}
+
+static std::string timestamp ( )
+{
+    std::time_t const now = std::chrono::system_clock::to_time_t (
+            std::chrono::system_clock::now ( ) );
+    std::tm utc { };
+#if defined( WINDOWS )
+    gmtime_s ( &utc, &now );
+#else
+    gmtime_r ( &now, &utc );
+#endif
+    char text [ 32 ] = { };
+    std::strftime ( text, sizeof ( text ), "%Y-%m-%dT%H:%M:%SZ", &utc );
+    return text;
+}
+
+host::description host::describe ( )
+{
+    std::set< unsigned > packages;
+    for ( auto const &cpu : topology::logical_cpus ( ) )
+    {
+        packages.insert ( cpu.package );
+    }
+    auto const &clock = timing::calibrated ( );
+
+    return {
+            cpu_model ( ),
+            topology::logical_cpus ( ).size ( ),
+            topology::physical_cores ( ),
+            packages.size ( ),
+            kernel ( ),
+            hostname ( ),
+            compiler ( ),
+#if defined( MARKBENCH_FLAGS )
+            MARKBENCH_FLAGS,
+#else
+            unknown,
+#endif
+            timestamp ( ),
+            timing::source_name ( clock.kind ),
+            clock.ticks_per_nanosecond,
+            timing::nanoseconds ( clock.overhead ),
+            isa::level_name ( isa::selected ( ) ),
+    };
+}
+
+std::size_t host::meminfo ( std::string const &field )
+{
+#if defined( LINUX )
+    std::ifstream meminfo ( "/proc/meminfo" );
+    std::string   line;
+    while ( std::getline ( meminfo, line ) )
+    {
+        if ( line.starts_with ( field + ":" ) )
+        {
+            std::istringstream values ( line.substr ( field.size ( ) + 1 ) );
+            std::size_t        value = 0;
+            std::string        unit;
+            values >> value >> unit;
+            return unit == "kB" ? value << 10 : value;
+        }
+    }
+#endif
+    return 0;
+}
+
+std::size_t host::last_level_cache ( )
+{
+    std::size_t result = 0;
+#if defined( LINUX )
+    // cpu0's caches, from the L1s up. Each size is e.g. "2048K".
+    for ( unsigned index = 0;; index++ )
+    {
+        std::ifstream size { "/sys/devices/system/cpu/cpu0/cache/index"
+                             + std::to_string ( index ) + "/size" };
+        std::size_t   value = 0;
+        char          unit  = 0;
+        if ( !( size >> value ) )
+        {
+            break;
+        }
+        size >> unit;
+        value <<= unit == 'K' ? 10 : unit == 'M' ? 20 : 0;
+        result = std::max ( result, value );
+    }
+#endif
+    return result;
+}
+
+std::string host::memory_shortfall ( std::size_t const bytes )
+{
+    // in MiB, or in KiB below one, which would otherwise print as 0 MiB
+    auto const readable = [] ( std::size_t const size ) {
+        return size < ( 1 << 20 ) ? std::to_string ( size >> 10 ) + " KiB"
+                                  : std::to_string ( size >> 20 ) + " MiB";
+    };
+    std::size_t const available = meminfo ( "MemAvailable" );
+    if ( available > 0 && bytes > available / 4 * 3 )
+    {
+        return "it needs " + readable ( bytes ) + " and only "
+             + readable ( available ) + " is available";
+    }
+    return { };
+}
@@ -0,0 +1,62 @@
+/**
+ * @file host.hh
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief What machine (and what build) a set of results came from.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace markbench::host
+{
+    struct description
+    {
+        std::string cpu_model;
+        std::size_t logical_cpus;
+        std::size_t physical_cores;
+        std::size_t packages;
+        // operating system and kernel release, e.g., "Linux 6.1.0".
+        std::string kernel;
+        std::string hostname;
+        std::string compiler;
+        // the flags markbench was built with, if the makefile told us.
+        std::string flags;
+        // when the description was taken, as UTC in ISO 8601.
+        std::string timestamp;
+        // the clock that timed the tests. See timing::calibrated.
+        std::string timer;
+        long double timer_ghz;
+        long double timer_overhead_ns;
+        // the x86-64 level the compute kernels ran at. See isa::selected.
+        std::string isa;
+    };
+
+    /**
+     * @brief Describes this machine. Anything we cannot find out is
+     * "unknown".
+     */
+    description describe ( );
+
+    /**
+     * @brief A field of /proc/meminfo, in bytes if it has a unit and as is
+     * if it is a count. 0 if unknown, which it always is off Linux.
+     */
+    std::size_t meminfo ( std::string const &field );
+
+    // the size of the biggest cache, in bytes. 0 if unknown.
+    std::size_t last_level_cache ( );
+
+    /**
+     * @brief Why a test cannot have bytes of memory: how much it needs and how
+     * much is available, if that is more than three quarters of
+     * MemAvailable. Empty if it fits, or if the available memory is unknown.
+     */
+    std::string memory_shortfall ( std::size_t bytes );
+} // namespace markbench::host
@@ -0,0 +1,350 @@
+/**
+ * @file instructions.cc
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief The instruction kernels, in inline assembly so that the compiler can
+ * neither reorder nor remove them.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+
+#include "instructions.hh"
+#include "cpu-features.hh"
+#include "timing.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace instructions = markbench::instructions;
+
+// every kernel is its body repeated until it has executed per_iteration of
+// the instruction under test, so count is per_iteration over the number of
+// instructions in body.
+#define MARKBENCH_REPEAT( count, body ) ".rept " #count "\n\t" body ".endr\n\t"
+
+// VEX-encoded, so they clear the upper halves of the ymm registers as well.
+#define MARKBENCH_ZERO_YMM0 "vpxor %%xmm0, %%xmm0, %%xmm0\n\t"
+#define MARKBENCH_ZERO_YMM0_7                                                  \
+    "vpxor %%xmm0, %%xmm0, %%xmm0\n\t"                                         \
+    "vpxor %%xmm1, %%xmm1, %%xmm1\n\t"                                         \
+    "vpxor %%xmm2, %%xmm2, %%xmm2\n\t"                                         \
+    "vpxor %%xmm3, %%xmm3, %%xmm3\n\t"                                         \
+    "vpxor %%xmm4, %%xmm4, %%xmm4\n\t"                                         \
+    "vpxor %%xmm5, %%xmm5, %%xmm5\n\t"                                         \
+    "vpxor %%xmm6, %%xmm6, %%xmm6\n\t"                                         \
+    "vpxor %%xmm7, %%xmm7, %%xmm7\n\t"
+
+// or every SSE instruction after the kernel pays for the dirty upper halves.
+#define MARKBENCH_END_AVX "vzeroupper\n\t"
+
+// the same ymm instruction on ymm0 through ymm7.
+#define MARKBENCH_EIGHT_YMM( op )                                              \
+    op " %%ymm0, %%ymm0, %%ymm0\n\t" op " %%ymm1, %%ymm1, %%ymm1\n\t" op       \
+       " %%ymm2, %%ymm2, %%ymm2\n\t" op " %%ymm3, %%ymm3, %%ymm3\n\t" op       \
+       " %%ymm4, %%ymm4, %%ymm4\n\t" op " %%ymm5, %%ymm5, %%ymm5\n\t" op       \
+       " %%ymm6, %%ymm6, %%ymm6\n\t" op " %%ymm7, %%ymm7, %%ymm7\n\t"
+
+// the same scalar instruction on operands 0 through 7.
+#define MARKBENCH_EIGHT_REGISTERS( op )                                        \
+    op " %0, %0\n\t" op " %1, %1\n\t" op " %2, %2\n\t" op " %3, %3\n\t" op     \
+       " %4, %4\n\t" op " %5, %5\n\t" op " %6, %6\n\t" op " %7, %7\n\t"
+
+// the same shift by one on operands 0 through 7.
+#define MARKBENCH_EIGHT_SHIFTS( op )                                           \
+    op " $1, %0\n\t" op " $1, %1\n\t" op " $1, %2\n\t" op " $1, %3\n\t" op     \
+       " $1, %4\n\t" op " $1, %5\n\t" op " $1, %6\n\t" op " $1, %7\n\t"
+
+#define MARKBENCH_EIGHT_OPERANDS                                               \
+    "+r"( a ), "+r"( b ), "+r"( c ), "+r"( d ), "+r"( e ), "+r"( f ),          \
+            "+r"( g ), "+r"( h )
+
+#define MARKBENCH_YMM0_7                                                       \
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7"
+
+namespace
+{
+#if defined( __x86_64__ )
+    /**
+     * @brief Scalar kernels. The value in each register does not matter, only
+     * that every instruction waits for the one before it in its chain.
+     */
+    void add_latency ( )
+    {
+        std::uint64_t a = 1;
+        asm volatile ( MARKBENCH_REPEAT ( 256, "add %0, %0\n\t" )
+                       : "+r"( a ) );
+    }
+
+    void add_throughput ( )
+    {
+        std::uint64_t a = 1, b = 1, c = 1, d = 1, e = 1, f = 1, g = 1, h = 1;
+        asm volatile (
+                MARKBENCH_REPEAT ( 32, MARKBENCH_EIGHT_REGISTERS ( "add" ) )
+                : MARKBENCH_EIGHT_OPERANDS );
+    }
+
+    void sal_latency ( )
+    {
+        std::uint64_t a = 1;
+        asm volatile ( MARKBENCH_REPEAT ( 256, "sal $1, %0\n\t" )
+                       : "+r"( a ) );
+    }
+
+    void sal_throughput ( )
+    {
+        std::uint64_t a = 1, b = 1, c = 1, d = 1, e = 1, f = 1, g = 1, h = 1;
+        asm volatile (
+                MARKBENCH_REPEAT ( 32, MARKBENCH_EIGHT_SHIFTS ( "sal" ) )
+                : MARKBENCH_EIGHT_OPERANDS );
+    }
+
+    void sar_latency ( )
+    {
+        std::uint64_t a = 1;
+        asm volatile ( MARKBENCH_REPEAT ( 256, "sar $1, %0\n\t" )
+                       : "+r"( a ) );
+    }
+
+    void sar_throughput ( )
+    {
+        std::uint64_t a = 1, b = 1, c = 1, d = 1, e = 1, f = 1, g = 1, h = 1;
+        asm volatile (
+                MARKBENCH_REPEAT ( 32, MARKBENCH_EIGHT_SHIFTS ( "sar" ) )
+                : MARKBENCH_EIGHT_OPERANDS );
+    }
+
+    // two chains, interleaved, so a core that issues two adds a cycle can
+    // retire both every cycle.
+    void add_two_chains ( )
+    {
+        std::uint64_t a = 1, b = 1;
+        asm volatile ( MARKBENCH_REPEAT ( 128, "add %0, %0\n\tadd %1, %1\n\t" )
+                       : "+r"( a ), "+r"( b ) );
+    }
+
+    /**
+     * @brief Vector kernels, on zeroed registers so that no floating point
+     * value is ever denormal.
+     */
+    void vpaddq_latency ( )
+    {
+        asm volatile ( MARKBENCH_ZERO_YMM0 MARKBENCH_REPEAT (
+                               256, "vpaddq %%ymm0, %%ymm0, %%ymm0\n\t" )
+                               MARKBENCH_END_AVX ::
+                                       : "xmm0" );
+    }
+
+    void vpaddq_throughput ( )
+    {
+        asm volatile ( MARKBENCH_ZERO_YMM0_7 MARKBENCH_REPEAT (
+                               32, MARKBENCH_EIGHT_YMM ( "vpaddq" ) )
+                               MARKBENCH_END_AVX ::
+                                       : MARKBENCH_YMM0_7 );
+    }
+
+    void vaddpd_latency ( )
+    {
+        asm volatile ( MARKBENCH_ZERO_YMM0 MARKBENCH_REPEAT (
+                               256, "vaddpd %%ymm0, %%ymm0, %%ymm0\n\t" )
+                               MARKBENCH_END_AVX ::
+                                       : "xmm0" );
+    }
+
+    void vaddpd_throughput ( )
+    {
+        asm volatile ( MARKBENCH_ZERO_YMM0_7 MARKBENCH_REPEAT (
+                               32, MARKBENCH_EIGHT_YMM ( "vaddpd" ) )
+                               MARKBENCH_END_AVX ::
+                                       : MARKBENCH_YMM0_7 );
+    }
+
+    void vaddps_latency ( )
+    {
+        asm volatile ( MARKBENCH_ZERO_YMM0 MARKBENCH_REPEAT (
+                               256, "vaddps %%ymm0, %%ymm0, %%ymm0\n\t" )
+                               MARKBENCH_END_AVX ::
+                                       : "xmm0" );
+    }
+
+    void vaddps_throughput ( )
+    {
+        asm volatile ( MARKBENCH_ZERO_YMM0_7 MARKBENCH_REPEAT (
+                               32, MARKBENCH_EIGHT_YMM ( "vaddps" ) )
+                               MARKBENCH_END_AVX ::
+                                       : MARKBENCH_YMM0_7 );
+    }
+
+    // rsqrt(0) is infinity and rsqrt(infinity) is 0, neither of which the
+    // lookup table needs a microcode assist for.
+    void vrsqrtps_latency ( )
+    {
+        asm volatile ( MARKBENCH_ZERO_YMM0 MARKBENCH_REPEAT (
+                               256, "vrsqrtps %%ymm0, %%ymm0\n\t" )
+                               MARKBENCH_END_AVX ::
+                                       : "xmm0" );
+    }
+
+    void vrsqrtps_throughput ( )
+    {
+        asm volatile ( MARKBENCH_ZERO_YMM0_7 MARKBENCH_REPEAT (
+                               32,
+                               "vrsqrtps %%ymm0, %%ymm0\n\t"
+                               "vrsqrtps %%ymm1, %%ymm1\n\t"
+                               "vrsqrtps %%ymm2, %%ymm2\n\t"
+                               "vrsqrtps %%ymm3, %%ymm3\n\t"
+                               "vrsqrtps %%ymm4, %%ymm4\n\t"
+                               "vrsqrtps %%ymm5, %%ymm5\n\t"
+                               "vrsqrtps %%ymm6, %%ymm6\n\t"
+                               "vrsqrtps %%ymm7, %%ymm7\n\t" )
+                               MARKBENCH_END_AVX ::
+                                       : MARKBENCH_YMM0_7 );
+    }
+
+    // one scalar and one vector chain, which go to different ports.
+    void mixed_add_latency ( )
+    {
+        std::uint64_t a = 1;
+        asm volatile ( MARKBENCH_ZERO_YMM0 MARKBENCH_REPEAT (
+                               128,
+                               "add %0, %0\n\t"
+                               "vpaddq %%ymm0, %%ymm0, %%ymm0\n\t" )
+                               MARKBENCH_END_AVX
+                       : "+r"( a )
+                       :
+                       : "xmm0" );
+    }
+
+    void mixed_add_throughput ( )
+    {
+        std::uint64_t a = 1, b = 1, c = 1, d = 1;
+        asm volatile ( MARKBENCH_ZERO_YMM0_7 MARKBENCH_REPEAT (
+                               32,
+                               "add %0, %0\n\t"
+                               "vpaddq %%ymm0, %%ymm0, %%ymm0\n\t"
+                               "add %1, %1\n\t"
+                               "vpaddq %%ymm1, %%ymm1, %%ymm1\n\t"
+                               "add %2, %2\n\t"
+                               "vpaddq %%ymm2, %%ymm2, %%ymm2\n\t"
+                               "add %3, %3\n\t"
+                               "vpaddq %%ymm3, %%ymm3, %%ymm3\n\t" )
+                               MARKBENCH_END_AVX
+                       : "+r"( a ), "+r"( b ), "+r"( c ), "+r"( d )
+                       :
+                       : "xmm0", "xmm1", "xmm2", "xmm3" );
+    }
+#else
+    // never run: every test here is unavailable off x86-64.
+    void add_latency ( ) { }
+    void add_throughput ( ) { }
+    void sal_latency ( ) { }
+    void sal_throughput ( ) { }
+    void sar_latency ( ) { }
+    void sar_throughput ( ) { }
+    void add_two_chains ( ) { }
+    void vpaddq_latency ( ) { }
+    void vpaddq_throughput ( ) { }
+    void vaddpd_latency ( ) { }
+    void vaddpd_throughput ( ) { }
+    void vaddps_latency ( ) { }
+    void vaddps_throughput ( ) { }
+    void vrsqrtps_latency ( ) { }
+    void vrsqrtps_throughput ( ) { }
+    void mixed_add_latency ( ) { }
+    void mixed_add_throughput ( ) { }
+#endif
+
+    template < auto kernel >
+    individual_test instruction_test (
+            std::string const                             &name_id,
+            std::function< std::string const &( ) > const &unavailable )
+    {
+        individual_test result = batched_test< kernel > ( name_id );
+        result.unavailable     = unavailable;
+        result.instructions    = instructions::per_iteration;
+        return result;
+    }
+} // namespace
+
+test_suite instructions::suite ( )
+{
+    auto const scalar = markbench::cpu::needs_x86_64;
+    auto const avx    = markbench::cpu::needs_avx;
+    auto const avx2   = markbench::cpu::needs_avx2;
+    return test_suite {
+            instruction_test< add_latency > ( "test.instr.add.latency",
+                                              scalar ),
+            instruction_test< add_throughput > ( "test.instr.add.throughput",
+                                                 scalar ),
+            instruction_test< vpaddq_latency > ( "test.instr.vpaddq.latency",
+                                                 avx2 ),
+            instruction_test< vpaddq_throughput > (
+                    "test.instr.vpaddq.throughput",
+                    avx2 ),
+            instruction_test< mixed_add_latency > (
+                    "test.instr.mixed_add.latency",
+                    avx2 ),
+            instruction_test< mixed_add_throughput > (
+                    "test.instr.mixed_add.throughput",
+                    avx2 ),
+            instruction_test< sal_latency > ( "test.instr.sal.latency",
+                                              scalar ),
+            instruction_test< sal_throughput > ( "test.instr.sal.throughput",
+                                                 scalar ),
+            instruction_test< sar_latency > ( "test.instr.sar.latency",
+                                              scalar ),
+            instruction_test< sar_throughput > ( "test.instr.sar.throughput",
+                                                 scalar ),
+            instruction_test< vaddpd_latency > ( "test.instr.vaddpd.latency",
+                                                 avx ),
+            instruction_test< vaddpd_throughput > (
+                    "test.instr.vaddpd.throughput",
+                    avx ),
+            instruction_test< vaddps_latency > ( "test.instr.vaddps.latency",
+                                                 avx ),
+            instruction_test< vaddps_throughput > (
+                    "test.instr.vaddps.throughput",
+                    avx ),
+            instruction_test< add_two_chains > ( "test.instr.two_chains",
+                                                 scalar ),
+            instruction_test< vrsqrtps_latency > (
+                    "test.instr.vrsqrtps.latency",
+                    avx ),
+            instruction_test< vrsqrtps_throughput > (
+                    "test.instr.vrsqrtps.throughput",
+                    avx ),
+            // one add per cycle, so its instructions per nanosecond are the
+            // clock in GHz.
+            instruction_test< add_latency > ( "test.instr.clock", scalar ),
+    };
+}
+
+long double instructions::estimate_clock ( )
+{
+    static long double const result = [] ( ) {
+        if ( !markbench::cpu::detect ( ).x86_64 )
+        {
+            return std::nanl ( "" );
+        }
+        // about a millisecond a try at any plausible clock.
+        static constexpr std::size_t repeats = 4096;
+        static constexpr std::size_t tries   = 20;
+
+        markbench::timing::calibrated ( );
+        long double best = 0;
+        for ( std::size_t i = 0; i < tries; i++ )
+        {
+            markbench::timing::ticks const start = markbench::timing::start ( );
+            for ( std::size_t j = 0; j < repeats; j++ ) { add_latency ( ); }
+            markbench::timing::ticks const stop = markbench::timing::stop ( );
+            long double const nanoseconds =
+                    markbench::timing::nanoseconds ( stop - start );
+            best = std::max ( best, repeats * per_iteration / nanoseconds );
+        }
+        return best;
+    }( );
+    return result;
+}
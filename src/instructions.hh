@@ -0,0 +1,41 @@
+/**
+ * @file instructions.hh
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Tests of single instructions, each as a dependent chain (latency)
+ * and as independent chains (throughput), counted in instructions per cycle.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+#pragma once
+
+#include "test-suite.hh"
+
+#include <string>
+
+namespace markbench::instructions
+{
+    /**
+     * @brief How many of the instruction under test one iteration of every
+     * kernel here executes, i.e., individual_test::instructions.
+     */
+    inline constexpr std::size_t per_iteration = 256;
+
+    /**
+     * @brief Every instruction test, the ones this processor cannot run
+     * included (they report themselves unavailable).
+     */
+    test_suite suite ( );
+
+    /**
+     * @brief The core clock in GHz, from how fast a chain of dependent adds
+     * runs. One add per cycle on every x86 core since the P6, so it runs at
+     * whatever clock scalar code gets, without the performance counters. The
+     * best of a few tries, measured once and then remembered. NaN if not on
+     * x86-64.
+     */
+    long double estimate_clock ( );
+} // namespace markbench::instructions
@@ -0,0 +1,239 @@
+/**
+ * @file isa-dispatch.cc
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Builds the compute kernels at every level and picks one.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+
+#include "isa-dispatch.hh"
+#include "cpu-features.hh"
+
+#include <stdexcept>
+
+// -O2 does not vectorize loops in gcc 10, which would leave every level with
+// the same scalar code. So the kernels of every level, baseline included, are
+// vectorized, and the levels differ only in the instructions they may use.
+#pragma GCC optimize( "tree-vectorize" )
+
+// every standard header the kernels use is included here, before any
+// #pragma GCC target. Otherwise the library's inline functions could be
+// compiled for a newer level and the linker could keep that copy for the
+// baseline code too.
+#define MARKBENCH_ISA_NAMESPACE baseline
+#include "compute-kernels.hh"
+#undef MARKBENCH_ISA_NAMESPACE
+
+// gcc 10 has no arch=x86-64-v2 and so on, so the levels are spelled out.
+#if defined( __x86_64__ )
+#    define MARKBENCH_HAS_LEVELS 1
+
+#    pragma GCC push_options
+#    pragma GCC target( "popcnt,sse3,ssse3,sse4.1,sse4.2,cx16,sahf" )
+#    define MARKBENCH_ISA_NAMESPACE v2
+#    include "compute-kernels.hh"
+#    undef MARKBENCH_ISA_NAMESPACE
+#    pragma GCC pop_options
+
+#    pragma GCC push_options
+#    pragma GCC target( "popcnt,sse3,ssse3,sse4.1,sse4.2,cx16,sahf,avx,avx2," \
+                        "bmi,bmi2,f16c,fma,lzcnt,movbe,xsave" )
+#    define MARKBENCH_ISA_NAMESPACE v3
+#    include "compute-kernels.hh"
+#    undef MARKBENCH_ISA_NAMESPACE
+#    pragma GCC pop_options
+
+#    pragma GCC push_options
+#    pragma GCC target( "popcnt,sse3,ssse3,sse4.1,sse4.2,cx16,sahf,avx,avx2," \
+                        "bmi,bmi2,f16c,fma,lzcnt,movbe,xsave,avx512f,"         \
+                        "avx512bw,avx512cd,avx512dq,avx512vl" )
+#    define MARKBENCH_ISA_NAMESPACE v4
+#    include "compute-kernels.hh"
+#    undef MARKBENCH_ISA_NAMESPACE
+#    pragma GCC pop_options
+#endif
+
+namespace isa = markbench::isa;
+
+namespace
+{
+    /**
+     * @brief One level's kernels.
+     */
+    struct kernels
+    {
+        void ( *primes_sieve ) ( );
+        isa::sieve_plan ( *make_sieve_plan ) ( std::uint64_t );
+        std::uint64_t ( *sieve_segment ) ( isa::sieve_plan const &,
+                                           std::uint64_t,
+                                           std::uint64_t * );
+        bool ( *valid_prime_count ) ( std::uint64_t, std::uint64_t );
+        void ( *isqrt ) ( );
+        float ( *echelon_single ) ( isa::matrix_rows< float > const & );
+        double ( *echelon_double ) ( isa::matrix_rows< double > const & );
+        long double ( *echelon_triple ) (
+                isa::matrix_rows< long double > const & );
+    };
+
+// the kernels of the level built in namespace name.
+#define MARKBENCH_KERNELS( name )                                              \
+    {                                                                          \
+        isa::name::primes_sieve, isa::name::make_sieve_plan,                   \
+                isa::name::sieve_segment, isa::name::valid_prime_count,        \
+                isa::name::isqrt, isa::name::echelon< float >,                 \
+                isa::name::echelon< double >,                                  \
+                isa::name::echelon< long double >,                             \
+    }
+
+    kernels const &table ( isa::level const l )
+    {
+        static kernels const baseline MARKBENCH_KERNELS ( baseline );
+#if defined( MARKBENCH_HAS_LEVELS )
+        static kernels const v2 MARKBENCH_KERNELS ( v2 );
+        static kernels const v3 MARKBENCH_KERNELS ( v3 );
+        static kernels const v4 MARKBENCH_KERNELS ( v4 );
+        switch ( l )
+        {
+            case isa::level::v2: return v2;
+            case isa::level::v3: return v3;
+            case isa::level::v4: return v4;
+            default: return baseline;
+        }
+#else
+        return baseline;
+#endif
+    }
+
+#undef MARKBENCH_KERNELS
+
+    // null until the first kernel runs or a level is forced.
+    kernels const *current = nullptr;
+    isa::level     current_level;
+
+    kernels const &active ( )
+    {
+        if ( !current )
+        {
+            current_level = isa::best ( );
+            current       = &table ( current_level );
+        }
+        return *current;
+    }
+} // namespace
+
+std::string isa::level_name ( level const l )
+{
+    switch ( l )
+    {
+        case level::baseline: return "x86-64";
+        case level::v2: return "x86-64-v2";
+        case level::v3: return "x86-64-v3";
+        case level::v4: return "x86-64-v4";
+        default: return "?";
+    }
+}
+
+isa::level isa::parse_level ( std::string const &name )
+{
+    for ( auto const l : { level::baseline, level::v2, level::v3, level::v4 } )
+    {
+        if ( name == level_name ( l ) )
+        {
+            return l;
+        }
+    }
+    if ( name == "baseline" || name == "v1" )
+    {
+        return level::baseline;
+    } else if ( name == "v2" )
+    {
+        return level::v2;
+    } else if ( name == "v3" )
+    {
+        return level::v3;
+    } else if ( name == "v4" )
+    {
+        return level::v4;
+    }
+    throw std::invalid_argument ( "Unknown instruction set level " + name );
+}
+
+bool isa::supported ( level const l )
+{
+#if defined( MARKBENCH_HAS_LEVELS )
+    return unsigned ( l ) < markbench::cpu::detect ( ).level;
+#else
+    return l == level::baseline;
+#endif
+}
+
+isa::level isa::best ( )
+{
+    level result = level::baseline;
+    for ( auto const l : { level::v2, level::v3, level::v4 } )
+    {
+        if ( supported ( l ) )
+        {
+            result = l;
+        }
+    }
+    return result;
+}
+
+void isa::force ( level const l )
+{
+    if ( !supported ( l ) )
+    {
+        throw std::invalid_argument ( "This processor cannot run "
+                                      + level_name ( l ) + " code" );
+    }
+    current_level = l;
+    current       = &table ( l );
+}
+
+isa::level isa::selected ( )
+{
+    active ( );
+    return current_level;
+}
+
+void isa::primes_sieve ( ) { active ( ).primes_sieve ( ); }
+
+isa::sieve_plan isa::make_sieve_plan ( std::uint64_t const limit )
+{
+    return active ( ).make_sieve_plan ( limit );
+}
+
+std::uint64_t isa::sieve_segment ( sieve_plan const   &plan,
+                                   std::uint64_t const segment,
+                                   std::uint64_t      *bits )
+{
+    return active ( ).sieve_segment ( plan, segment, bits );
+}
+
+bool isa::valid_prime_count ( std::uint64_t const limit,
+                              std::uint64_t const count )
+{
+    return active ( ).valid_prime_count ( limit, count );
+}
+
+void isa::isqrt ( ) { active ( ).isqrt ( ); }
+
+float isa::echelon ( matrix_rows< float > const &m )
+{
+    return active ( ).echelon_single ( m );
+}
+
+double isa::echelon ( matrix_rows< double > const &m )
+{
+    return active ( ).echelon_double ( m );
+}
+
+long double isa::echelon ( matrix_rows< long double > const &m )
+{
+    return active ( ).echelon_triple ( m );
+}
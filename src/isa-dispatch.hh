@@ -0,0 +1,109 @@
+/**
+ * @file isa-dispatch.hh
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief The compute kernels, built once per x86-64 microarchitecture level
+ * and picked at runtime, so one binary both runs on the oldest machines and
+ * uses the vector units of the newest.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace markbench::isa
+{
+    enum class level
+    {
+        // x86-64 as AMD first shipped it, or whatever the compiler targets
+        // off x86.
+        baseline,
+        // + popcnt, sse3, ssse3, sse4.1, sse4.2, cmpxchg16b.
+        v2,
+        // + avx, avx2, bmi, bmi2, f16c, fma, lzcnt, movbe.
+        v3,
+        // + avx512 f, bw, cd, dq and vl.
+        v4,
+    };
+
+    // "x86-64", "x86-64-v2" and so on.
+    std::string level_name ( level const l );
+
+    /**
+     * @brief The level named by baseline, v2, v3, v4, or the level_name of
+     * one. Throws std::invalid_argument for anything else.
+     */
+    level parse_level ( std::string const &name );
+
+    // whether this binary has the level and the processor can run it.
+    bool supported ( level const l );
+
+    // the highest supported level.
+    level best ( );
+
+    /**
+     * @brief Runs every kernel at the given level from now on instead of the
+     * best one. Throws std::invalid_argument if it is not supported. Only
+     * before any test starts.
+     */
+    void force ( level const l );
+
+    // the level the kernels run at.
+    level selected ( );
+
+    template < std::floating_point F >
+    using matrix_rows = std::vector< std::vector< F > >;
+
+    // one segment of a segmented sieve: 32 KiB of bits, which fits in the L1
+    // data cache, for the odd numbers among 128 * 4096 in a row.
+    inline constexpr std::size_t sieve_segment_words = 4096;
+
+    /**
+     * @brief What every segment of a segmented sieve of the numbers below
+     * limit reads and none of them writes, so that any thread can sieve any
+     * segment.
+     */
+    struct sieve_plan
+    {
+        std::uint64_t                limit    = 0;
+        std::uint64_t                segments = 0;
+        // the odd primes from 17 whose squares are below limit.
+        std::vector< std::uint32_t > primes;
+        // the bits of the odd numbers with 3, 5, 7, 11 and 13 crossed off,
+        // which repeat every 15015 words.
+        std::vector< std::uint64_t > presieve;
+    };
+
+    // the kernels, at the selected level.
+
+    // sieves the primes below a million, and throws std::logic_error if it
+    // counts them wrong.
+    void primes_sieve ( );
+    sieve_plan make_sieve_plan ( std::uint64_t const limit );
+    /**
+     * @brief Sieves one segment of the plan in bits, which holds
+     * sieve_segment_words words, and returns how many primes it has. The
+     * segments' counts add up to the primes below the plan's limit.
+     */
+    std::uint64_t sieve_segment ( sieve_plan const   &plan,
+                                  std::uint64_t const segment,
+                                  std::uint64_t      *bits );
+    // whether there are count primes below limit, for every power of 10 up
+    // to 10^10. False for any other limit.
+    bool valid_prime_count ( std::uint64_t const limit,
+                             std::uint64_t const count );
+    // normalizes a 3D vector and moves it along.
+    void isqrt ( );
+    // the first element of the reduced row echelon form of a matrix.
+    float       echelon ( matrix_rows< float > const &m );
+    double      echelon ( matrix_rows< double > const &m );
+    long double echelon ( matrix_rows< long double > const &m );
+} // namespace markbench::isa
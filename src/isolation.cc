@@ -0,0 +1,305 @@
+/**
+ * @file isolation.cc
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Forks a worker process per test pass.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+
+#include "isolation.hh"
+
+#if defined( LINUX ) || defined( DARWIN )
+#    include <sys/wait.h>
+#    include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace isolation = markbench::isolation;
+
+namespace
+{
+    /**
+     * @brief Appends values as raw bytes. Both ends are the same binary on
+     * the same machine, so there is no need for a portable format.
+     */
+    class encoder
+    {
+    public:
+        std::string bytes;
+
+        template < typename T > void put ( T const &x )
+        {
+            if constexpr ( std::is_trivially_copyable_v< T > )
+            {
+                bytes.append ( reinterpret_cast< char const * > ( &x ),
+                               sizeof ( T ) );
+            } else
+            {
+                static_assert ( sizeof ( T ) == 0, "no encoding for T" );
+            }
+        }
+
+        void put ( std::string const &text )
+        {
+            put ( text.size ( ) );
+            bytes += text;
+        }
+
+        template < typename T > void put ( std::vector< T > const &v )
+        {
+            put ( v.size ( ) );
+            for ( auto const &x : v ) { put ( T ( x ) ); }
+        }
+
+        void put ( markbench::latency::distribution const &d )
+        {
+            put ( d.buckets ( ) );
+            put ( d.maximum ( ) );
+        }
+
+        void put ( markbench::test_result const &r )
+        {
+            put ( r.counters );
+            put ( r.elapsed );
+            put ( r.windows );
+            put ( r.relative_error );
+            put ( r.placement );
+            put ( r.events );
+            put ( r.latencies );
+            put ( r.loop_overhead );
+        }
+    };
+
+    class decoder
+    {
+        std::string const &bytes;
+        std::size_t        at = 0;
+
+        void need ( std::size_t const size ) const
+        {
+            if ( bytes.size ( ) - at < size )
+            {
+                throw std::runtime_error ( "The pass record was cut short" );
+            }
+        }
+    public:
+        explicit decoder ( std::string const &bytes ) : bytes { bytes } { }
+
+        template < typename T > void get ( T &x )
+        {
+            if constexpr ( std::is_trivially_copyable_v< T > )
+            {
+                need ( sizeof ( T ) );
+                std::memcpy ( &x, bytes.data ( ) + at, sizeof ( T ) );
+                at += sizeof ( T );
+            } else
+            {
+                static_assert ( sizeof ( T ) == 0, "no decoding for T" );
+            }
+        }
+
+        void get ( std::string &text )
+        {
+            std::size_t size;
+            get ( size );
+            need ( size );
+            text = bytes.substr ( at, size );
+            at += size;
+        }
+
+        template < typename T > void get ( std::vector< T > &v )
+        {
+            std::size_t size;
+            get ( size );
+            v.clear ( );
+            for ( std::size_t i = 0; i < size; i++ )
+            {
+                T x;
+                get ( x );
+                v.push_back ( x );
+            }
+        }
+
+        void get ( markbench::latency::distribution &d )
+        {
+            std::vector< std::uint64_t > buckets;
+            std::uint64_t                maximum;
+            get ( buckets );
+            get ( maximum );
+            d = { buckets, maximum };
+        }
+
+        void get ( markbench::test_result &r )
+        {
+            get ( r.counters );
+            get ( r.elapsed );
+            get ( r.windows );
+            get ( r.relative_error );
+            get ( r.placement );
+            get ( r.events );
+            get ( r.latencies );
+            get ( r.loop_overhead );
+        }
+
+        bool finished ( ) const noexcept { return at == bytes.size ( ); }
+    };
+} // namespace
+
+std::string isolation::encode ( pass_record const &record )
+{
+    encoder e;
+    e.put ( record.id );
+    e.put ( record.threads );
+    e.put ( record.placement );
+    e.put ( record.trials );
+    e.put ( record.rejected );
+    e.put ( record.summary );
+    e.put ( record.latencies );
+    e.put ( record.clocks );
+    e.put ( record.throttled );
+    e.put ( record.rerun );
+    e.put ( record.instructions_per_cycle );
+    e.put ( record.core_gigahertz );
+    e.put ( record.nanoseconds_per_load );
+    e.put ( record.gigabytes_per_second );
+    e.put ( record.bytes_per_cycle );
+    return e.bytes;
+}
+
+pass_record isolation::decode ( std::string const &bytes )
+{
+    decoder     d { bytes };
+    pass_record record;
+    d.get ( record.id );
+    d.get ( record.threads );
+    d.get ( record.placement );
+    d.get ( record.trials );
+    d.get ( record.rejected );
+    d.get ( record.summary );
+    d.get ( record.latencies );
+    d.get ( record.clocks );
+    d.get ( record.throttled );
+    d.get ( record.rerun );
+    d.get ( record.instructions_per_cycle );
+    d.get ( record.core_gigahertz );
+    d.get ( record.nanoseconds_per_load );
+    d.get ( record.gigabytes_per_second );
+    d.get ( record.bytes_per_cycle );
+    if ( !d.finished ( ) )
+    {
+        throw std::runtime_error ( "The pass record has bytes left over" );
+    }
+    return record;
+}
+
+#if defined( LINUX ) || defined( DARWIN )
+
+bool isolation::supported ( ) noexcept { return true; }
+
+isolation::outcome isolation::run_isolated (
+        std::function< pass_record ( ) > const &measure )
+{
+    int ends [ 2 ];
+    if ( pipe ( ends ) != 0 )
+    {
+        return { .failure = std::string ( "no pipe: " )
+                          + std::strerror ( errno ) };
+    }
+    pid_t const child = fork ( );
+    if ( child < 0 )
+    {
+        close ( ends [ 0 ] );
+        close ( ends [ 1 ] );
+        return { .failure = std::string ( "no fork: " )
+                          + std::strerror ( errno ) };
+    }
+
+    if ( child == 0 )
+    {
+        close ( ends [ 0 ] );
+        int status = 0;
+        try
+        {
+            std::string const bytes = encode ( measure ( ) );
+            for ( std::size_t sent = 0; sent < bytes.size ( ); )
+            {
+                ssize_t const n = write ( ends [ 1 ],
+                                          bytes.data ( ) + sent,
+                                          bytes.size ( ) - sent );
+                if ( n < 0 && errno != EINTR )
+                {
+                    status = 1;
+                    break;
+                }
+                sent += n > 0 ? n : 0;
+            }
+        } catch ( std::exception const &e )
+        {
+            std::cerr << e.what ( ) << "\n";
+            status = 1;
+        }
+        close ( ends [ 1 ] );
+        std::cout.flush ( );
+        std::clog.flush ( );
+        // skips the atexit handlers and static destructors, which belong to
+        // the parent.
+        _exit ( status );
+    }
+
+    close ( ends [ 1 ] );
+    std::string bytes;
+    char        buffer [ 65536 ];
+    for ( ;; )
+    {
+        ssize_t const n = read ( ends [ 0 ], buffer, sizeof ( buffer ) );
+        if ( n > 0 )
+        {
+            bytes.append ( buffer, n );
+        } else if ( n == 0 || errno != EINTR )
+        {
+            break;
+        }
+    }
+    close ( ends [ 0 ] );
+
+    int status = 0;
+    while ( waitpid ( child, &status, 0 ) < 0 && errno == EINTR ) { }
+    if ( WIFSIGNALED ( status ) )
+    {
+        return { .failure = std::string ( "it crashed (" )
+                          + strsignal ( WTERMSIG ( status ) ) + ")" };
+    }
+    if ( !WIFEXITED ( status ) || WEXITSTATUS ( status ) != 0 )
+    {
+        return { .failure = "it exited with status "
+                          + std::to_string ( WEXITSTATUS ( status ) ) };
+    }
+    try
+    {
+        return { "", decode ( bytes ) };
+    } catch ( std::exception const &e )
+    {
+        return { .failure = e.what ( ) };
+    }
+}
+
+#else
+
+bool isolation::supported ( ) noexcept { return false; }
+
+isolation::outcome isolation::run_isolated (
+        std::function< pass_record ( ) > const &measure )
+{
+    return { "", measure ( ) };
+}
+
+#endif
@@ -0,0 +1,53 @@
+/**
+ * @file isolation.hh
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Runs a test pass in a process of its own, so that it starts from a
+ * clean heap and cache and a crash only loses that pass.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+#pragma once
+
+#include "test-runner.hh"
+
+#include <functional>
+#include <string>
+
+namespace markbench::isolation
+{
+    /**
+     * @brief Whether run_isolated really makes a new process. Needs fork,
+     * so not on Windows.
+     */
+    bool supported ( ) noexcept;
+
+    /**
+     * @brief What came back from the child process.
+     */
+    struct outcome
+    {
+        // empty if the child finished and sent back a whole record.
+        std::string failure;
+        pass_record record { };
+    };
+
+    /**
+     * @brief Forks, runs measure in the child, and sends the record it
+     * returns back to the parent over a pipe. The child inherits the standard
+     * streams, so anything it prints still shows up. The caller flushes its
+     * streams first.
+     */
+    outcome run_isolated ( std::function< pass_record ( ) > const &measure );
+
+    /**
+     * @brief The parts of a pass record that a child measures, as bytes, and
+     * back.
+     * @throw std::runtime_error from decode if the bytes are cut short.
+     */
+    std::string encode ( pass_record const &record );
+    pass_record decode ( std::string const &bytes );
+} // namespace markbench::isolation
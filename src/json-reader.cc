@@ -0,0 +1,260 @@
+/**
+ * @file json-reader.cc
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief A small recursive-descent JSON parser.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+
+#include "json-reader.hh"
+
+#include <cstdlib>
+#include <stdexcept>
+
+namespace json = markbench::json;
+
+bool json::value::contains ( std::string const &key ) const
+{
+    if ( !std::holds_alternative< object > ( data ) )
+    {
+        return false;
+    }
+    for ( auto const &[ k, v ] : std::get< object > ( data ) )
+    {
+        if ( k == key )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+json::value const &json::value::operator[] ( std::string const &key ) const
+{
+    if ( std::holds_alternative< object > ( data ) )
+    {
+        for ( auto const &[ k, v ] : std::get< object > ( data ) )
+        {
+            if ( k == key )
+            {
+                return v;
+            }
+        }
+    }
+    throw std::out_of_range ( "No member \"" + key + "\"" );
+}
+
+bool json::value::as_bool ( ) const { return std::get< bool > ( data ); }
+
+long double json::value::as_number ( ) const
+{
+    return std::get< long double > ( data );
+}
+
+std::string const &json::value::as_string ( ) const
+{
+    return std::get< std::string > ( data );
+}
+
+json::value::array const &json::value::as_array ( ) const
+{
+    return std::get< array > ( data );
+}
+
+json::value::object const &json::value::as_object ( ) const
+{
+    return std::get< object > ( data );
+}
+
+namespace
+{
+    class parser
+    {
+        std::string const &text;
+        std::size_t        at = 0;
+
+        [[noreturn]] void fail ( std::string const &what ) const
+        {
+            throw std::runtime_error ( "JSON: " + what + " at offset "
+                                       + std::to_string ( at ) );
+        }
+
+        void skip_space ( )
+        {
+            while ( at < text.size ( )
+                    && ( text [ at ] == ' ' || text [ at ] == '\t'
+                         || text [ at ] == '\n' || text [ at ] == '\r' ) )
+            {
+                at++;
+            }
+        }
+
+        char peek ( )
+        {
+            skip_space ( );
+            if ( at >= text.size ( ) )
+            {
+                fail ( "unexpected end" );
+            }
+            return text [ at ];
+        }
+
+        void expect ( char const c )
+        {
+            if ( peek ( ) != c )
+            {
+                fail ( std::string ( "expected '" ) + c + "'" );
+            }
+            at++;
+        }
+
+        bool literal ( std::string const &word )
+        {
+            if ( text.compare ( at, word.size ( ), word ) == 0 )
+            {
+                at += word.size ( );
+                return true;
+            }
+            return false;
+        }
+
+        std::string string ( )
+        {
+            expect ( '"' );
+            std::string result;
+            while ( at < text.size ( ) && text [ at ] != '"' )
+            {
+                char c = text [ at++ ];
+                if ( c == '\\' )
+                {
+                    if ( at >= text.size ( ) )
+                    {
+                        fail ( "unfinished escape" );
+                    }
+                    switch ( c = text [ at++ ] )
+                    {
+                        case 'n': c = '\n'; break;
+                        case 't': c = '\t'; break;
+                        case 'r': c = '\r'; break;
+                        case 'b': c = '\b'; break;
+                        case 'f': c = '\f'; break;
+                        case 'u':
+                        {
+                            if ( at + 4 > text.size ( ) )
+                            {
+                                fail ( "unfinished escape" );
+                            }
+                            unsigned long const code = std::stoul (
+                                    text.substr ( at, 4 ),
+                                    nullptr,
+                                    16 );
+                            at += 4;
+                            // we only ever write control characters this
+                            // way, so anything wider is kept as a '?'.
+                            c = code < 0x80 ? char ( code ) : '?';
+                            break;
+                        }
+                        default: break;
+                    }
+                }
+                result += c;
+            }
+            if ( at >= text.size ( ) )
+            {
+                fail ( "unfinished string" );
+            }
+            at++;
+            return result;
+        }
+
+        json::value number ( )
+        {
+            char const *const start = text.c_str ( ) + at;
+            char             *end   = nullptr;
+            long double const x     = std::strtold ( start, &end );
+            if ( end == start )
+            {
+                fail ( "expected a value" );
+            }
+            at += end - start;
+            return x;
+        }
+    public:
+        explicit parser ( std::string const &text ) : text { text } { }
+
+        json::value any ( )
+        {
+            switch ( peek ( ) )
+            {
+                case '{':
+                {
+                    at++;
+                    json::value::object members;
+                    if ( peek ( ) == '}' )
+                    {
+                        at++;
+                        return members;
+                    }
+                    do {
+                        std::string key = string ( );
+                        expect ( ':' );
+                        members.emplace_back ( std::move ( key ), any ( ) );
+                    } while ( peek ( ) == ',' && ++at );
+                    expect ( '}' );
+                    return members;
+                }
+                case '[':
+                {
+                    at++;
+                    json::value::array elements;
+                    if ( peek ( ) == ']' )
+                    {
+                        at++;
+                        return elements;
+                    }
+                    do {
+                        elements.push_back ( any ( ) );
+                    } while ( peek ( ) == ',' && ++at );
+                    expect ( ']' );
+                    return elements;
+                }
+                case '"': return string ( );
+                default:
+                    if ( literal ( "true" ) )
+                    {
+                        return true;
+                    }
+                    if ( literal ( "false" ) )
+                    {
+                        return false;
+                    }
+                    if ( literal ( "null" ) )
+                    {
+                        return json::value { };
+                    }
+                    return number ( );
+            }
+        }
+
+        void finish ( )
+        {
+            skip_space ( );
+            if ( at != text.size ( ) )
+            {
+                fail ( "trailing text" );
+            }
+        }
+    };
+} // namespace
+
+json::value json::parse ( std::string const &text )
+{
+    parser      p { text };
+    json::value result = p.any ( );
+    p.finish ( );
+    return result;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file json-reader.hh
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Just enough JSON to read our own results files back in.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace markbench::json
+{
+    class value
+    {
+    public:
+        using array  = std::vector< value >;
+        // kept in document order. Our files never have many keys.
+        using object = std::vector< std::pair< std::string, value > >;
+    private:
+        std::variant< std::nullptr_t,
+                      bool,
+                      long double,
+                      std::string,
+                      array,
+                      object >
+                data;
+    public:
+        value ( ) : data { nullptr } { }
+
+        template < typename T >
+            requires (
+                    !std::is_same_v< std::remove_cvref_t< T >, value > )
+        value ( T &&x ) : data { std::forward< T > ( x ) }
+        { }
+
+        bool is_null ( ) const noexcept
+        {
+            return std::holds_alternative< std::nullptr_t > ( data );
+        }
+
+        bool contains ( std::string const &key ) const;
+
+        /**
+         * @brief The member with the given key.
+         * @throw std::out_of_range if this is not an object or has no such
+         * member.
+         */
+        value const &operator[] ( std::string const &key ) const;
+
+        /**
+         * @throw std::bad_variant_access if this is not of that type.
+         */
+        bool               as_bool ( ) const;
+        long double        as_number ( ) const;
+        std::string const &as_string ( ) const;
+        array const       &as_array ( ) const;
+        object const      &as_object ( ) const;
+    };
+
+    /**
+     * @brief Parses one JSON document.
+     * @throw std::runtime_error saying where the text stopped making sense.
+     */
+    value parse ( std::string const &text );
+} // namespace markbench::json
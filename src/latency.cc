@@ -0,0 +1,115 @@
+/**
+ * @file latency.cc
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Log-linear latency histograms.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+
+#include "latency.hh"
+
+#include "timing.hh"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace latency = markbench::latency;
+
+std::size_t latency::bucket_of ( std::uint64_t const value ) noexcept
+{
+    // the first two powers of two fit exactly.
+    if ( value < 2 * sub_buckets )
+    {
+        return value;
+    }
+    unsigned const shift = std::bit_width ( value ) - sub_bucket_bits - 1;
+    return ( shift + 1 ) * sub_buckets + ( ( value >> shift ) - sub_buckets );
+}
+
+std::uint64_t latency::highest_in_bucket ( std::size_t const bucket ) noexcept
+{
+    if ( bucket < 2 * sub_buckets )
+    {
+        return bucket;
+    }
+    unsigned const      shift  = bucket / sub_buckets - 1;
+    std::uint64_t const lowest = ( bucket % sub_buckets + sub_buckets )
+                              << shift;
+    return lowest + ( ( std::uint64_t { 1 } << shift ) - 1 );
+}
+
+latency::distribution::distribution ( std::vector< std::uint64_t > buckets,
+                                      std::uint64_t const maximum ) :
+        counts { std::move ( buckets ) },
+        largest { maximum }
+{
+    for ( auto const c : counts ) { total += c; }
+}
+
+latency::distribution &
+        latency::distribution::operator+= ( distribution const &that )
+{
+    if ( counts.size ( ) < that.counts.size ( ) )
+    {
+        counts.resize ( that.counts.size ( ), 0 );
+    }
+    for ( std::size_t i = 0; i < that.counts.size ( ); i++ )
+    {
+        counts [ i ] += that.counts [ i ];
+    }
+    total += that.total;
+    largest = std::max ( largest, that.largest );
+    return *this;
+}
+
+std::uint64_t latency::distribution::percentile ( long double const p ) const
+{
+    if ( empty ( ) )
+    {
+        return 0;
+    }
+    std::uint64_t const wanted = std::max< std::uint64_t > (
+            1,
+            std::ceil ( std::clamp ( p, 0.0L, 1.0L ) * total ) );
+    std::uint64_t seen = 0;
+    for ( std::size_t i = 0; i < counts.size ( ); i++ )
+    {
+        seen += counts [ i ];
+        if ( seen >= wanted )
+        {
+            return std::min ( highest_in_bucket ( i ), largest );
+        }
+    }
+    return largest;
+}
+
+latency::recorder::recorder ( std::chrono::nanoseconds const overhead ) :
+        counts { new std::atomic_uint64_t [ bucket_count ] },
+        overhead ( overhead.count ( ) )
+{
+    for ( std::size_t i = 0; i < bucket_count; i++ )
+    {
+        counts [ i ].store ( 0, std::memory_order_relaxed );
+    }
+}
+
+latency::distribution latency::recorder::snapshot ( ) const
+{
+    std::vector< std::uint64_t > buckets ( bucket_count );
+    for ( std::size_t i = 0; i < bucket_count; i++ )
+    {
+        buckets [ i ] = counts [ i ].load ( std::memory_order_relaxed );
+    }
+    return { std::move ( buckets ),
+             largest.load ( std::memory_order_relaxed ) };
+}
+
+std::chrono::nanoseconds latency::timer_overhead ( )
+{
+    return timing::to_duration ( timing::calibrated ( ).overhead );
+}
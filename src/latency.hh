@@ -0,0 +1,117 @@
+/**
+ * @file latency.hh
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Per-iteration latency histograms, since a good mean can hide a bad
+ * tail.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+#pragma once
+
+#include "counters.hh"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace markbench::latency
+{
+    /**
+     * @brief The histograms are log-linear (like HdrHistogram): every power of
+     * two is split into 2^sub_bucket_bits equal buckets, so every recorded
+     * value is off by less than 1 part in 2^sub_bucket_bits (under 1%) from
+     * zero up to the full range of a 64-bit count of nanoseconds.
+     */
+    inline constexpr unsigned    sub_bucket_bits = 7;
+    inline constexpr std::size_t sub_buckets     = std::size_t { 1 }
+                                              << sub_bucket_bits;
+    inline constexpr std::size_t bucket_count =
+            ( 65 - sub_bucket_bits ) * sub_buckets;
+
+    std::size_t bucket_of ( std::uint64_t const value ) noexcept;
+
+    /**
+     * @brief The largest value that lands in the given bucket.
+     */
+    std::uint64_t highest_in_bucket ( std::size_t const bucket ) noexcept;
+
+    /**
+     * @brief A finished histogram of latencies in nanoseconds. Empty (no
+     * buckets at all) when nothing was sampled.
+     */
+    class distribution
+    {
+        std::vector< std::uint64_t > counts;
+        std::uint64_t                total   = 0;
+        std::uint64_t                largest = 0;
+    public:
+        distribution ( ) = default;
+        distribution ( std::vector< std::uint64_t > buckets,
+                       std::uint64_t const          maximum );
+
+        bool          empty ( ) const noexcept { return total == 0; }
+        std::uint64_t count ( ) const noexcept { return total; }
+        std::uint64_t maximum ( ) const noexcept { return largest; }
+
+        std::vector< std::uint64_t > const &buckets ( ) const noexcept
+        {
+            return counts;
+        }
+
+        distribution &operator+= ( distribution const &that );
+
+        /**
+         * @brief The latency that the fraction p of the samples are at or
+         * under, e.g., p = 0.99 for the 99th percentile. Rounded up to the top
+         * of its bucket, but never over the largest sample.
+         */
+        std::uint64_t percentile ( long double const p ) const;
+    };
+
+    /**
+     * @brief One thread's histogram. Only the owning thread records into it,
+     * so recording is a relaxed load and store with no locks and no
+     * read-modify-write, and anyone can take a snapshot at any time.
+     */
+    class alignas ( cache_line ) recorder
+    {
+        std::unique_ptr< std::atomic_uint64_t [] > counts;
+        std::atomic_uint64_t                       largest = 0;
+        std::uint64_t                              overhead;
+    public:
+        /**
+         * @param overhead subtracted from every sample. See timer_overhead.
+         */
+        explicit recorder ( std::chrono::nanoseconds const overhead );
+
+        inline void record ( std::chrono::nanoseconds const elapsed ) noexcept
+        {
+            std::uint64_t const raw   = elapsed.count ( );
+            std::uint64_t const value = raw > overhead ? raw - overhead : 0;
+            auto &bucket = counts [ bucket_of ( value ) ];
+            bucket.store ( bucket.load ( std::memory_order_relaxed ) + 1,
+                           std::memory_order_relaxed );
+            if ( value > largest.load ( std::memory_order_relaxed ) )
+            {
+                largest.store ( value, std::memory_order_relaxed );
+            }
+        }
+
+        distribution snapshot ( ) const;
+    };
+
+    /**
+     * @brief What it costs to read the clock twice back to back, i.e., what
+     * timing an iteration adds to it. The smallest of many tries, so that
+     * subtracting it never makes a sample smaller than it really was. See
+     * timing::calibration::overhead.
+     */
+    std::chrono::nanoseconds timer_overhead ( );
+} // namespace markbench::latency
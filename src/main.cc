@@ -10,51 +10,192 @@
  *
  */
 
+#include "command-line.hh"
+#include "compare.hh"
+#include "host.hh"
 #include "messages.hh"
+#include "results-writer.hh"
 #include "test-runner.hh"
 #include "test-suite.hh"
 #include "test-utils.hh"
 #include "test.hh"
 
 #include <algorithm>
+#include <fstream>
 #include <iostream>
 #include <random>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 
-#if defined( LINUX )
-#    include "gtk/gtk.h"
-#endif
-
 using test_id_pair = std::tuple< markbench::test_function, std::string >;
 
-int main ( int argc, char **argv )
+/**
+ * @brief markbench compare <baseline.json> <current.json> [threshold=<percent>]
+ * [alpha=<p-value>]. Returns 1 if any test regressed, 2 if the files could not
+ * be compared, 0 otherwise.
+ */
+static int compare_results ( int argc, char **argv )
 {
-#if defined( LINUX )
-    gtk_init ( &argc, &argv );
-#endif
     using namespace markbench;
-
-    auto test_to_run = version_now;
-
-    if ( argc >= 2 )
+    if ( argc < 4 )
     {
-        if ( std::string ( argv [ 1 ] ) == "now" )
+        std::cerr << "Usage: " << argv [ 0 ]
+                  << " compare <baseline> <current> [threshold=<percent>] "
+                     "[alpha=<p-value>]\n";
+        return 2;
+    }
+    compare::thresholds limits;
+    try
+    {
+        for ( int i = 4; i < argc; i++ )
         {
-            std::cout << "Set to run " << argv [ 1 ] << "\n";
-            test_to_run = version_now;
+            std::string const argument = argv [ i ];
+            if ( argument.starts_with ( "threshold=" ) )
+            {
+                limits.change = command_line::parse_number (
+                                        argument, argument.substr ( 10 ) )
+                              / 100;
+                if ( limits.change < 0 )
+                {
+                    throw std::invalid_argument (
+                            "The threshold cannot be negative in "
+                            + argument );
+                }
+            } else if ( argument.starts_with ( "alpha=" ) )
+            {
+                limits.significance = command_line::parse_number (
+                        argument, argument.substr ( 6 ) );
+                if ( !( limits.significance > 0 && limits.significance < 1 ) )
+                {
+                    throw std::invalid_argument (
+                            "The p-value must be between 0 and 1 in "
+                            + argument );
+                }
+            } else
+            {
+                throw std::invalid_argument ( "Unknown argument " + argument );
+            }
         }
-        if ( std::string ( argv [ 1 ] ) == "000" )
+        compare::result_file const baseline = compare::load ( argv [ 2 ] );
+        compare::result_file const current  = compare::load ( argv [ 3 ] );
+        auto const changes = compare::compare ( baseline, current, limits );
+        std::cout << en_us_locale ( )->list_comparison ( baseline,
+                                                         current,
+                                                         changes );
+        for ( auto const &c : changes )
         {
-            std::cout << "Set to run " << argv [ 1 ] << "\n";
-            test_to_run = version_000;
+            if ( c.outcome == compare::verdict::regressed )
+            {
+                return 1;
+            }
         }
+        return 0;
+    } catch ( std::exception const &e )
+    {
+        std::cerr << e.what ( ) << "\n";
+        return 2;
+    }
+}
 
-        if ( std::string ( argv [ 1 ] ) == "001" )
+/**
+ * @brief Opens path to write results to, unless it is empty.
+ * @throw std::invalid_argument naming argument if it cannot be opened.
+ */
+static void open_results ( std::ofstream     &file,
+                           std::string const &argument,
+                           std::string const &path )
+{
+    if ( path.empty ( ) )
+    {
+        return;
+    }
+    file.open ( path );
+    if ( !file.is_open ( ) )
+    {
+        throw std::invalid_argument ( "Cannot write to " + argument + path );
+    }
+}
+
+int main ( int argc, char **argv )
+{
+    if ( argc >= 2 && std::string ( argv [ 1 ] ) == "compare" )
+    {
+        return compare_results ( argc, argv );
+    }
+    using namespace markbench;
+
+    std::ostringstream     notes;
+    command_line::settings settings;
+    try
+    {
+        settings = command_line::parse ( argc, argv, notes );
+    } catch ( std::invalid_argument const &e )
+    {
+        std::cerr << e.what ( ) << "\n"
+                  << en_us_locale ( )->usage ( argv [ 0 ] );
+        return 2;
+    }
+    if ( settings.help )
+    {
+        std::cout << en_us_locale ( )->usage ( argv [ 0 ] );
+        return 0;
+    }
+    if ( settings.list )
+    {
+        for ( auto const &t : settings.suite )
         {
-            std::cout << "Set to run " << argv [ 1 ] << "\n";
-            test_to_run = version_001;
+            std::cout << t.name_id << "\n";
         }
+        return 0;
+    }
+    // opened before the run, so that a path that cannot be written is
+    // reported now instead of after the whole suite.
+    std::ofstream json_file;
+    std::ofstream csv_file;
+    try
+    {
+        open_results ( json_file, "json=", settings.json_path );
+        open_results ( csv_file, "csv=", settings.csv_path );
+    } catch ( std::invalid_argument const &e )
+    {
+        std::cerr << e.what ( ) << "\n";
+        return 2;
     }
 
-    test_runner ( en_us_locale ( ), test_to_run ( ) ).run_test ( );
+    // standard output is for the results file unless they are text.
+    bool const    text = settings.format == command_line::output_format::text;
+    std::ostream &log  = text ? std::cout : std::clog;
+    settings.options.log = &log;
+    log << notes.str ( );
+
+    test_runner runner ( en_us_locale ( ), settings.suite, settings.options );
+    runner.run_test ( );
+
+    results::run_report const report {
+            settings.version,
+            host::describe ( ),
+            runner.passes ( ),
+            runner.skipped ( ),
+            runner.single_score ( ),
+            runner.multi_score ( ),
+            runner.single_error ( ),
+            runner.multi_error ( ),
+    };
+    if ( settings.format == command_line::output_format::json )
+    {
+        results::write_json ( std::cout, report );
+    }
+    if ( settings.format == command_line::output_format::csv )
+    {
+        results::write_csv ( std::cout, report );
+    }
+    if ( json_file.is_open ( ) )
+    {
+        results::write_json ( json_file, report );
+    }
+    if ( csv_file.is_open ( ) )
+    {
+        results::write_csv ( csv_file, report );
+    }
 }
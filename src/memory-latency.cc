@@ -0,0 +1,279 @@
+/**
+ * @file memory-latency.cc
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Builds the pointer-chasing rings and chases them.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+
+#include "memory-latency.hh"
+#include "host.hh"
+#include "test-utils.hh"
+
+#if defined( LINUX )
+#    include <sys/mman.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <new>
+
+namespace host           = markbench::host;
+namespace memory_latency = markbench::memory_latency;
+
+namespace
+{
+    constexpr std::size_t smallest       = std::size_t ( 4 ) << 10;
+    constexpr std::size_t largest        = std::size_t ( 4 ) << 30;
+    constexpr std::size_t huge_page_size = std::size_t ( 2 ) << 20;
+
+    /**
+     * @brief One cache line, which points to the next one in the ring.
+     */
+    struct alignas ( 64 ) node
+    {
+        node const *next;
+    };
+
+    /**
+     * @brief Memory for a ring, on the page size asked for. Falls back to
+     * transparent huge pages when none are reserved, and keeps transparent
+     * huge pages away from the ring that is meant to be on 4 KiB pages.
+     */
+    class region
+    {
+        // what was mapped, and the part of it that the ring is in.
+        void       *base   = nullptr;
+        std::size_t mapped = 0;
+        void       *memory = nullptr;
+    public:
+        region ( std::size_t const bytes, bool const huge_pages )
+        {
+#if defined( LINUX )
+            std::size_t const rounded = ( bytes + huge_page_size - 1 )
+                                      / huge_page_size * huge_page_size;
+            if ( huge_pages )
+            {
+                mapped = rounded;
+                base   = mmap ( nullptr,
+                              mapped,
+                              PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                              -1,
+                              0 );
+                if ( base != MAP_FAILED )
+                {
+                    memory = base;
+                    return;
+                }
+                // one huge page more, so that the ring can start on a huge
+                // page boundary, or the kernel cannot back its ends with
+                // transparent huge pages.
+                mapped = rounded + huge_page_size;
+            } else
+            {
+                mapped = bytes;
+            }
+            base = mmap ( nullptr,
+                          mapped,
+                          PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS,
+                          -1,
+                          0 );
+            if ( base == MAP_FAILED )
+            {
+                throw std::bad_alloc ( );
+            }
+            memory = base;
+            if ( huge_pages )
+            {
+                auto const address =
+                        reinterpret_cast< std::uintptr_t > ( base );
+                memory = reinterpret_cast< void * > (
+                        ( address + huge_page_size - 1 ) / huge_page_size
+                        * huge_page_size );
+            }
+            madvise ( memory,
+                      huge_pages ? rounded : bytes,
+                      huge_pages ? MADV_HUGEPAGE : MADV_NOHUGEPAGE );
+#else
+            mapped = bytes;
+            memory = ::operator new ( bytes, std::align_val_t { 64 } );
+#endif
+        }
+
+        ~region ( )
+        {
+#if defined( LINUX )
+            munmap ( base, mapped );
+#else
+            ::operator delete ( memory, std::align_val_t { 64 } );
+#endif
+        }
+
+        region ( region const & )            = delete;
+        region &operator= ( region const & ) = delete;
+
+        node *nodes ( ) const noexcept
+        {
+            return static_cast< node * > ( memory );
+        }
+    };
+
+    /**
+     * @brief Every cache line of the working set, linked in a random order
+     * into a single cycle, so that neither the prefetchers nor the
+     * out-of-order core can guess the next load.
+     */
+    class ring
+    {
+        // where each thread starts, spread evenly around the ring so that the
+        // threads do not walk it in lockstep.
+        static constexpr std::size_t start_count = 1024;
+
+        region                      lines;
+        std::vector< node const * > starts;
+    public:
+        explicit ring ( memory_latency::working_set const &size ) :
+                lines { size.bytes, size.huge_pages }
+        {
+            std::size_t const            count = size.bytes / sizeof ( node );
+            std::vector< std::uint32_t > order ( count );
+            for ( std::size_t i = 0; i < count; i++ ) { order [ i ] = i; }
+            // the same ring every time for the same size.
+            rng random ( size.bytes );
+            std::shuffle ( order.begin ( ), order.end ( ), random );
+
+            node *const nodes = lines.nodes ( );
+            for ( std::size_t i = 0; i < count; i++ )
+            {
+                std::size_t const next = order [ ( i + 1 ) % count ];
+                nodes [ order [ i ] ].next = &nodes [ next ];
+            }
+            std::size_t const spread = std::min ( count, start_count );
+            for ( std::size_t i = 0; i < spread; i++ )
+            {
+                starts.push_back ( &nodes [ order [ i * count / spread ] ] );
+            }
+        }
+
+        node const *start ( markbench::fixture_context const &context ) const
+        {
+            return starts [ context.thread * starts.size ( )
+                            / context.threads ];
+        }
+    };
+
+    /**
+     * @brief The per-thread fixture of a ladder test.
+     */
+    class chase
+    {
+        // shared by every thread of a pass, so that the memory it takes does
+        // not grow with the thread count.
+        std::shared_ptr< ring const > shared;
+        node const                   *cursor;
+    public:
+        chase ( memory_latency::working_set const &size,
+                markbench::fixture_context const  &context ) :
+                shared { shared_per_pass< ring const > ( size ) },
+                cursor { shared->start ( context ) }
+        { }
+
+        void operator( ) ( )
+        {
+            node const *at = cursor;
+            for ( std::size_t i = 0; i < memory_latency::per_iteration; i += 8 )
+            {
+                at = at->next;
+                at = at->next;
+                at = at->next;
+                at = at->next;
+                at = at->next;
+                at = at->next;
+                at = at->next;
+                at = at->next;
+            }
+            cursor = at;
+            keep_result ( cursor );
+        }
+    };
+
+    individual_test ladder_test ( memory_latency::working_set const &size )
+    {
+        std::string const id = std::string ( "test.memory_latency." )
+                             + ( size.huge_pages ? "huge_pages." : "pages." )
+                             + std::to_string ( size.bytes );
+        individual_test result = fixture_test< chase > ( id, size );
+        result.unavailable = [ size ] ( ) -> std::string const & {
+            static std::string reason;
+            reason = host::memory_shortfall ( size.bytes );
+#if defined( LINUX )
+            if ( size.huge_pages && host::meminfo ( "HugePages_Free" ) == 0 )
+            {
+                std::ifstream transparent (
+                        "/sys/kernel/mm/transparent_hugepage/enabled" );
+                std::string setting;
+                std::getline ( transparent, setting );
+                if ( setting.empty ( )
+                     || setting.find ( "[never]" ) != std::string::npos )
+                {
+                    reason = "no huge pages are reserved and transparent huge "
+                             "pages are off";
+                }
+            }
+#else
+            if ( size.huge_pages )
+            {
+                reason = "huge pages are only supported on Linux";
+            }
+#endif
+            return reason;
+        };
+        result.loads = memory_latency::per_iteration;
+        return result;
+    }
+} // namespace
+
+test_suite memory_latency::suite ( )
+{
+    test_suite result;
+    for ( bool const huge_pages : { false, true } )
+    {
+        for ( std::size_t bytes = smallest; bytes <= largest; bytes <<= 1 )
+        {
+            result.push_back ( ladder_test ( { bytes, huge_pages } ) );
+        }
+    }
+    return result;
+}
+
+std::optional< memory_latency::working_set >
+        memory_latency::parse_id ( std::string const &id )
+{
+    std::string const prefix = "test.memory_latency.";
+    if ( !id.starts_with ( prefix ) )
+    {
+        return std::nullopt;
+    }
+    std::string const rest = id.substr ( prefix.size ( ) );
+    auto const        dot  = rest.find ( '.' );
+    if ( dot == std::string::npos )
+    {
+        return std::nullopt;
+    }
+    try
+    {
+        return working_set { std::stoull ( rest.substr ( dot + 1 ) ),
+                             rest.substr ( 0, dot ) == "huge_pages" };
+    } catch ( std::exception const & )
+    {
+        return std::nullopt;
+    }
+}
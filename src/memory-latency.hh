@@ -0,0 +1,65 @@
+/**
+ * @file memory-latency.hh
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief The memory latency ladder: chasing pointers around a random ring of
+ * cache lines, at working sets from 4 KiB (the L1 cache) to gigabytes (DRAM),
+ * on ordinary and on huge pages.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+#pragma once
+
+#include "test-suite.hh"
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace markbench::memory_latency
+{
+    /**
+     * @brief How many dependent loads one iteration of every ladder test
+     * makes, i.e., individual_test::loads.
+     */
+    inline constexpr std::size_t per_iteration = 1024;
+
+    /**
+     * @brief The rungs of the ladder: every power of two from 4 KiB to
+     * 4 GiB, first on the base page size and then on huge pages. The rungs
+     * bigger than about three quarters of the available memory, or on huge
+     * pages where there are none, report themselves unavailable.
+     */
+    test_suite suite ( );
+
+    /**
+     * @brief What a ladder test chases pointers around.
+     */
+    struct working_set
+    {
+        std::size_t bytes;
+        bool        huge_pages;
+
+        bool operator== ( working_set const & ) const = default;
+    };
+
+    /**
+     * @brief The working set of the ladder test with the given id, or empty if
+     * it is not one.
+     */
+    std::optional< working_set > parse_id ( std::string const &id );
+
+    /**
+     * @brief One rung's result, for the table at the end of a run.
+     */
+    struct rung
+    {
+        std::string             id;
+        markbench::thread_count threads;
+        long double             nanoseconds_per_load;
+    };
+} // namespace markbench::memory_latency
@@ -12,8 +12,306 @@
 
 #include "messages.hh"
 
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+/**
+ * @brief std::to_string, but with significant figures instead of a fixed six
+ * decimal places. The slow tests score in the billionths of a rhedstone.
+ */
+static std::string significant ( long double const value )
+{
+    std::ostringstream stream;
+    stream << std::setprecision ( 6 ) << value;
+    return stream.str ( );
+}
+
+/**
+ * @brief The name of a test of a single instruction, from the part of its id
+ * after "test.instr.", e.g., "vaddpd.latency".
+ */
+static std::string instruction_name ( std::string const &id )
+{
+    auto const        dot  = id.find ( '.' );
+    std::string const base = id.substr ( 0, dot );
+    std::string const form = dot == std::string::npos ? ""
+                                                      : id.substr ( dot + 1 );
+    std::string       name = "!" + base + "!";
+    if ( base == "add" )
+    {
+        name = "ADD RAX, RAX";
+    } else if ( base == "vpaddq" )
+    {
+        name = "VPADDQ YMM0, YMM0, YMM0";
+    } else if ( base == "mixed_add" )
+    {
+        name = "ADD RAX, RAX ; VPADDQ YMM0, YMM0, YMM0";
+    } else if ( base == "sal" )
+    {
+        name = "SAL RAX, 1";
+    } else if ( base == "sar" )
+    {
+        name = "SAR RAX, 1";
+    } else if ( base == "vaddpd" )
+    {
+        name = "VADDPD YMM0, YMM0, YMM0";
+    } else if ( base == "vaddps" )
+    {
+        name = "VADDPS YMM0, YMM0, YMM0";
+    } else if ( base == "two_chains" )
+    {
+        name = "ADD RAX, RAX ; ADD RBX, RBX";
+    } else if ( base == "vrsqrtps" )
+    {
+        name = "VRSQRTPS (SIMD FISR)";
+    } else if ( base == "clock" )
+    {
+        name = "CPU clock estimation";
+    }
+    return form.empty ( ) ? name + " test" : name + " " + form + " test";
+}
+
+/**
+ * @brief A power-of-two size in the largest binary unit it is a whole number
+ * of, e.g., "64 KiB".
+ */
+static std::string binary_size ( std::size_t bytes )
+{
+    char const *units [] = { "B", "KiB", "MiB", "GiB", "TiB" };
+    std::size_t unit     = 0;
+    while ( bytes >= 1024 && bytes % 1024 == 0 && unit < 4 )
+    {
+        bytes /= 1024;
+        unit++;
+    }
+    return std::to_string ( bytes ) + " " + units [ unit ];
+}
+
+/**
+ * @brief The name of a memory latency test, e.g., "pointer chase over 64 KiB
+ * on huge pages".
+ */
+static std::string
+        ladder_name ( markbench::memory_latency::working_set const &size )
+{
+    return "pointer chase over " + binary_size ( size.bytes )
+         + ( size.huge_pages ? " on huge pages" : " on base pages" );
+}
+
+/**
+ * @brief The name of a bandwidth test, from the end of its id, e.g.,
+ * "triad.nontemporal".
+ */
+static std::string stream_name ( std::string const &id )
+{
+    auto const        dot    = id.find ( '.' );
+    std::string const kernel = id.substr ( 0, dot );
+    return "STREAM " + kernel + " bandwidth test"
+         + ( dot == std::string::npos ? "" : " with non-temporal stores" );
+}
+
+/**
+ * @brief The name of an AES test, from the end of its id, e.g.,
+ * "ctr.aesni.1024".
+ */
+static std::string aes_name ( std::string const &id )
+{
+    std::istringstream parts { id };
+    std::string        mode;
+    std::string        path;
+    std::string        bytes;
+    std::getline ( parts, mode, '.' );
+    std::getline ( parts, path, '.' );
+    std::getline ( parts, bytes );
+    std::string result = "AES-256 ";
+    if ( mode == "ctr" )
+    {
+        result += "CTR";
+    } else if ( mode == "cbc_encrypt" )
+    {
+        result += "CBC encryption";
+    } else if ( mode == "cbc_decrypt" )
+    {
+        result += "CBC decryption";
+    } else
+    {
+        result += mode;
+    }
+    try
+    {
+        result += " of " + binary_size ( std::stoull ( bytes ) );
+    } catch ( std::exception const & )
+    {
+        result += " of " + bytes + " bytes";
+    }
+    if ( path == "table" )
+    {
+        result += " with lookup tables";
+    } else if ( path == "aesni" )
+    {
+        result += " with AES-NI";
+    } else if ( path == "vaes" )
+    {
+        result += " with VAES";
+    } else
+    {
+        result += " with " + path;
+    }
+    return result + " test";
+}
+
+/**
+ * @brief The name of a hashing test, from the end of its id, e.g.,
+ * "sha256.shani.16384".
+ */
+static std::string hash_name ( std::string const &id )
+{
+    std::istringstream parts { id };
+    std::string        hash;
+    std::string        path;
+    std::string        bytes;
+    std::getline ( parts, hash, '.' );
+    std::getline ( parts, path, '.' );
+    std::getline ( parts, bytes );
+    std::string result = hash == "sha256" ? "SHA-256"
+                       : hash == "crc32c" ? "CRC32C"
+                                          : hash;
+    try
+    {
+        result += " of " + binary_size ( std::stoull ( bytes ) );
+    } catch ( std::exception const & )
+    {
+        result += " of " + bytes + " bytes";
+    }
+    if ( path == "scalar" )
+    {
+        result += " in portable code";
+    } else if ( path == "shani" )
+    {
+        result += " with SHA-NI";
+    } else if ( path == "sse42" )
+    {
+        result += " with SSE4.2";
+    } else if ( path == "pclmul" )
+    {
+        result += " with PCLMULQDQ";
+    } else
+    {
+        result += " with " + path;
+    }
+    return result + " test";
+}
+
+/**
+ * @brief The name of a segmented prime sieve test, from the end of its id,
+ * e.g., "cooperative.10000000000".
+ */
+static std::string primes_name ( std::string const &id )
+{
+    auto const        dot    = id.find ( '.' );
+    std::string const mode   = id.substr ( 0, dot );
+    std::string const limit  = dot == std::string::npos
+                                     ? "?"
+                                     : id.substr ( dot + 1 );
+    std::string       result = "segmented prime sieve below " + limit;
+    if ( mode == "replica" )
+    {
+        result += ", the whole range on each thread";
+    } else if ( mode == "cooperative" )
+    {
+        result += ", one range shared by every thread, a segment at a time";
+    } else
+    {
+        result += ", " + mode;
+    }
+    return result + " test";
+}
+
+/**
+ * @brief The name of a heap test, from the end of its id, e.g.,
+ * "churn.pool".
+ */
+static std::string heap_name ( std::string const &id )
+{
+    auto const        dot       = id.find ( '.' );
+    std::string const pattern   = id.substr ( 0, dot );
+    std::string const allocator = dot == std::string::npos
+                                        ? "?"
+                                        : id.substr ( dot + 1 );
+    std::string       result    = "heap ";
+    if ( pattern == "lifo" )
+    {
+        result += "allocate then free newest first";
+    } else if ( pattern == "random" )
+    {
+        result += "allocate then free in a random order";
+    } else if ( pattern == "churn" )
+    {
+        result += "fragmentation churn";
+    } else if ( pattern == "cross_thread" )
+    {
+        result += "free on another thread";
+    } else
+    {
+        result += pattern;
+    }
+    if ( allocator == "malloc" )
+    {
+        result += " through malloc";
+    } else if ( allocator == "pool" )
+    {
+        result += " through a per-thread pool";
+    } else if ( allocator == "arena" )
+    {
+        result += " through a per-thread arena";
+    } else if ( allocator == "shared_pool" )
+    {
+        result += " through a shared pool";
+    } else
+    {
+        result += " through " + allocator;
+    }
+    return result + " test";
+}
+
 class en_us_messages : public virtual message_generator
 {
+    std::string list_events ( markbench::perf::readings const &events )
+    {
+        using namespace markbench::perf;
+        if ( !events.any ( ) )
+        {
+            return "Performance counters unavailable (check "
+                   "/proc/sys/kernel/perf_event_paranoid)\n";
+        }
+
+        std::string result = "Performance counters over "
+                           + std::to_string ( events.iterations )
+                           + " iterations:\n";
+        result += "\t- instructions per cycle: "
+                + significant ( events.ratio ( instructions, cycles ) ) + "\n";
+        result += "\t- per iteration:";
+        for ( auto const e : { instructions, cycles } )
+        {
+            result += " " + significant ( events.per_iteration ( e ) ) + " "
+                    + event_name ( e ) + ";";
+        }
+        result += "\n\t- per thousand instructions:";
+        for ( auto const e :
+              { l1d_misses, llc_misses, branch_misses, dtlb_misses } )
+        {
+            result += " " + significant ( events.per_kilo_instruction ( e ) )
+                    + " " + event_name ( e ) + ";";
+        }
+        result += "\n\t- miss rates: "
+                + significant ( 100 * events.ratio ( l1d_misses, l1d_loads ) )
+                + "% of L1D loads; "
+                + significant ( 100
+                                * events.ratio ( llc_misses, llc_references ) )
+                + "% of LLC references;\n";
+        return result;
+    }
 public:
     std::string
             test_message ( std::string const             &id,
@@ -63,6 +361,32 @@ public:
             result +=
                     "find the rref of a matix of single-precision floating "
                     "points test";
+        } else if ( id.starts_with ( "test.aes." ) )
+        {
+            result += aes_name ( id.substr ( 9 ) );
+        } else if ( id.starts_with ( "test.entropy." ) )
+        {
+            result += "draw " + id.substr ( 13 )
+                    + " bytes from the operating system's CSPRNG test";
+        } else if ( id.starts_with ( "test.hash." ) )
+        {
+            result += hash_name ( id.substr ( 10 ) );
+        } else if ( id.starts_with ( "test.heap." ) )
+        {
+            result += heap_name ( id.substr ( 10 ) );
+        } else if ( id.starts_with ( "test.primes." ) )
+        {
+            result += primes_name ( id.substr ( 12 ) );
+        } else if ( id.starts_with ( "test.stream." ) )
+        {
+            result += stream_name ( id.substr ( 12 ) );
+        } else if ( id.starts_with ( "test.instr." ) )
+        {
+            result += instruction_name ( id.substr ( 11 ) );
+        } else if ( auto const size
+                    = markbench::memory_latency::parse_id ( id ) )
+        {
+            result += ladder_name ( *size ) + " test";
         } else
         {
             result += "!" + id + "! test";
@@ -73,33 +397,367 @@ public:
     }
 
     std::string list_results (
-            markbench::test_counters const &results ) override final
+            markbench::test_result const &results ) override final
     {
-        if ( results.size ( ) == 1 )
+        std::string result;
+        if ( results.counters.size ( ) == 1 )
         {
-            return std::string ( "This computer scored a " )
-                 + std::to_string ( results.front ( ) ) + "\n";
+            result = std::string ( "This computer scored a " )
+                   + std::to_string ( results.counters.front ( ) ) + "\n";
         } else
         {
-            std::string result = "The threads on this computer scored:\n";
-            for ( auto const &r : results )
+            result = "The threads on this computer scored:\n";
+            for ( auto const &r : results.counters )
             {
                 result += "\t- " + std::to_string ( r ) + "\n";
             }
-            return result;
         }
+        if ( !results.placement.empty ( ) )
+        {
+            result += "Threads pinned to logical CPUs:";
+            for ( auto const &cpu : results.placement )
+            {
+                result += " " + ( cpu < 0 ? "(failed)" : std::to_string ( cpu ) );
+            }
+            result += "\n";
+        }
+        if ( results.events.attempted )
+        {
+            result += list_events ( results.events );
+        }
+        long double total = 0;
+        for ( auto const &c : results.counters ) { total += c; }
+        if ( total > 0 && results.loop_overhead > 0 )
+        {
+            std::chrono::duration< long double, std::nano > const elapsed =
+                    results.elapsed;
+            long double const per_iteration =
+                    elapsed.count ( ) * results.counters.size ( ) / total;
+            long double const corrected =
+                    per_iteration - results.loop_overhead;
+            result += "Each iteration took " + significant ( per_iteration )
+                    + " ns per thread, ";
+            if ( corrected > 0 )
+            {
+                result += significant ( corrected )
+                        + " ns without the loop's own ";
+            } else
+            {
+                result += "no more than the loop's own ";
+            }
+            result += significant ( results.loop_overhead ) + " ns\n";
+        }
+        std::chrono::duration< long double > const seconds = results.elapsed;
+        result += "Measured over " + std::to_string ( seconds.count ( ) )
+                + " seconds in " + std::to_string ( results.windows )
+                + " windows, ";
+        if ( std::isfinite ( results.relative_error ) )
+        {
+            result += "throughput is within +/- "
+                    + std::to_string ( results.relative_error * 100 )
+                    + "% (95% confidence)\n";
+        } else
+        {
+            result += "too few iterations to estimate the error\n";
+        }
+        return result;
+    }
+
+    std::string list_statistics (
+            markbench::statistics::summary const &trials ) override final
+    {
+        std::string result = "Over " + std::to_string ( trials.count )
+                           + " trials";
+        if ( trials.rejected )
+        {
+            result += " (" + std::to_string ( trials.rejected )
+                    + " more thrown out as outliers)";
+        }
+        result += ", in rhedstones:\n";
+        result += "\t- mean: " + significant ( trials.mean ) + "\n";
+        result += "\t- median: " + significant ( trials.median ) + "\n";
+        result += "\t- standard deviation: "
+                + significant ( trials.standard_deviation ) + "\n";
+        result += "\t- min / max: " + significant ( trials.minimum )
+                + " / " + significant ( trials.maximum ) + "\n";
+        if ( trials.count > 1 )
+        {
+            result += "\t- 95% confidence interval: "
+                    + significant ( trials.confidence_low ) + " to "
+                    + significant ( trials.confidence_high ) + "\n";
+        }
+        return result;
+    }
+
+    std::string list_latency (
+            markbench::latency::distribution const &latencies ) override final
+    {
+        if ( latencies.empty ( ) )
+        {
+            return "No iterations were timed.\n";
+        }
+        std::string result = "Latency per iteration over "
+                           + std::to_string ( latencies.count ( ) )
+                           + " iterations, in nanoseconds:\n";
+        static constexpr std::pair< char const *, long double > points [] = {
+                { "p50", 0.50L },
+                { "p90", 0.90L },
+                { "p99", 0.99L },
+                { "p99.9", 0.999L },
+        };
+        for ( auto const &[ name, p ] : points )
+        {
+            result += "\t- " + std::string ( name ) + ": "
+                    + std::to_string ( latencies.percentile ( p ) ) + "\n";
+        }
+        result += "\t- max: " + std::to_string ( latencies.maximum ( ) )
+                + "\n";
+        return result;
+    }
+
+    std::string list_clocks (
+            markbench::thermal::summary const &clocks ) override final
+    {
+        std::string result;
+        if ( clocks.has_clock ( ) )
+        {
+            result += "The CPUs averaged "
+                    + significant ( clocks.mean_megahertz ) + " MHz (at least "
+                    + significant ( clocks.minimum_megahertz ) + " MHz)";
+        }
+        if ( !std::isnan ( clocks.maximum_celsius ) )
+        {
+            result += ( result.empty ( ) ? "The hottest" : ", the hottest" )
+                    + std::string ( " thermal zone reached " )
+                    + significant ( clocks.maximum_celsius ) + " C";
+        }
+        return result.empty ( ) ? result : result + "\n";
+    }
+
+    std::string list_instructions (
+            long double const &per_cycle,
+            long double const &gigahertz ) override final
+    {
+        if ( std::isnan ( gigahertz ) )
+        {
+            return "Instructions per cycle unknown (no clock to count cycles "
+                   "by)\n";
+        }
+        return "Instructions per cycle: " + significant ( per_cycle ) + " at "
+             + significant ( gigahertz ) + " GHz\n";
+    }
+
+    std::string
+            list_bandwidth ( long double const &gigabytes_per_second,
+                             long double const &bytes_per_cycle ) override final
+    {
+        return "Throughput: " + significant ( gigabytes_per_second )
+             + " GB/s, " + significant ( bytes_per_cycle )
+             + " bytes per cycle on each thread\n";
+    }
+
+    std::string list_load_latency (
+            long double const &nanoseconds ) override final
+    {
+        return "Load-to-use latency: " + significant ( nanoseconds )
+             + " ns per load\n";
+    }
+
+    std::string list_ladder (
+            std::vector< markbench::memory_latency::rung > const &rungs )
+            override final
+    {
+        std::string result = "Memory latency ladder (ns per load):\n";
+        for ( auto const &r : rungs )
+        {
+            auto const size = markbench::memory_latency::parse_id ( r.id );
+            result += "\t- " + ( size ? ladder_name ( *size ) : r.id ) + " on "
+                    + std::to_string ( r.threads )
+                    + " threads: " + significant ( r.nanoseconds_per_load )
+                    + "\n";
+        }
+        return result;
+    }
+
+    std::string throttle_message (
+            long double const             &megahertz,
+            long double const             &usual,
+            markbench::thread_count const &threads,
+            bool const                    &rerunning ) override final
+    {
+        std::string result =
+                "THROTTLED: the CPUs ran at " + significant ( megahertz )
+                + " MHz, " + significant ( ( 1 - megahertz / usual ) * 100 )
+                + "% below the " + significant ( usual )
+                + " MHz of the other passes on " + std::to_string ( threads )
+                + " threads.";
+        return result
+             + ( rerunning ? " Cooling down to run it again.\n"
+                           : " Its results are suspect.\n" );
+    }
+
+    std::string list_scaling (
+            std::string const                             &id,
+            std::vector< markbench::scaling_point > const &points,
+            std::size_t const                             &knee ) override final
+    {
+        std::string result = "Thread scaling of " + id
+                           + " (threads: rhedstones, speedup, efficiency):\n";
+        for ( auto const &p : points )
+        {
+            result += "\t- " + std::to_string ( p.threads ) + ": "
+                    + significant ( p.throughput ) + ", "
+                    + significant ( p.speedup ) + "x, "
+                    + std::to_string ( p.efficiency * 100 ) + "%\n";
+        }
+        if ( points.size ( ) > 1 )
+        {
+            result += "Scaling falls off after "
+                    + std::to_string ( points.at ( knee ).threads )
+                    + " threads.\n";
+        }
+        return result;
     }
 
     std::string list_rhedstone_count (
             std::vector< long double > const &single,
-            std::vector< long double > const &multi ) override final
+            std::vector< long double > const &multi,
+            long double const                &single_error,
+            long double const                &multi_error ) override final
     {
         std::string result = "";
 
         result += "This computer's single-threaded performance is "
-                + std::to_string ( single.front ( ) ) + " rhedstones\n";
+                + std::to_string ( single.front ( ) ) + " +/- "
+                + std::to_string ( single_error ) + " rhedstones\n";
         result += "This computer's multi-threaded performance is "
-                + std::to_string ( multi.back ( ) ) + " rhedstones\n";
+                + std::to_string ( multi.back ( ) ) + " +/- "
+                + std::to_string ( multi_error ) + " rhedstones\n";
+        result += "(+/- is the 95% confidence interval)\n";
+        return result;
+    }
+
+    std::string skip_message ( std::string const &id,
+                               std::string const &reason ) override final
+    {
+        return "Skipping " + id + " because " + reason
+             + ". It does not count towards the score.\n";
+    }
+
+    std::string isa_message ( std::string const &level ) override final
+    {
+        return "Running the compute kernels built for " + level + "\n";
+    }
+
+    std::string timer_message (
+            markbench::timing::calibration const &clock ) override final
+    {
+        using markbench::timing::source;
+        std::string result = "Timing with the "
+                           + markbench::timing::source_name ( clock.kind );
+        if ( clock.kind != source::monotonic )
+        {
+            result += " counter at "
+                    + significant ( clock.ticks_per_nanosecond ) + " GHz";
+        } else if ( !clock.invariant_tsc )
+        {
+            result += " clock (no invariant time stamp counter)";
+        } else
+        {
+            result += " clock";
+        }
+        return result + ", " + significant ( markbench::timing::nanoseconds (
+                                       clock.overhead ) )
+             + " ns per reading\n";
+    }
+
+    std::string shuffle_message ( std::uintmax_t const &seed ) override final
+    {
+        return "Running the tests in the order of seed="
+             + std::to_string ( seed ) + "\n";
+    }
+
+    std::string usage ( std::string const &program ) override final
+    {
+        return "Usage: " + program + " [option...]\n"
+             + "       " + program
+             + " compare <baseline> <current> [threshold=<percent>] "
+               "[alpha=<p-value>]\n"
+               "Options:\n"
+               "  now, 000, 001          the suite version to run (now)\n"
+               "  instructions           the tests of single instructions\n"
+               "  memory-latency         the memory latency ladder\n"
+               "  stream                 the memory bandwidth tests\n"
+               "  heap                   the allocator stress tests\n"
+               "  entropy                the random number generator tests\n"
+               "  aes                    the AES-256 encryption tests\n"
+               "  hashing                the SHA-256 and CRC32C tests\n"
+               "  primes                 the segmented prime sieve tests\n"
+               "  include=<glob>         only the tests whose id matches, "
+               "e.g., test.matrix_*\n"
+               "  exclude=<glob>         not the tests whose id matches\n"
+               "  list                   print the chosen test ids and stop\n"
+               "  threads=<list>         thread counts, e.g., 1,2,4-8,cores,all"
+               "\n"
+               "  sweep                  threads 1, 2, 4, ..., cores and all\n"
+               "  duration=<seconds>     the longest one trial runs (10)\n"
+               "  trials=<count>         trials per test and thread count (5)\n"
+               "  warmup=<seconds>       unmeasured run before the trials "
+               "(0.5)\n"
+               "  throttle=<percent>     flag passes whose clock fell this far "
+               "(5)\n"
+               "  rerun                  cool down and rerun flagged passes\n"
+               "  isolate                run every pass in a new process\n"
+               "  seed=<number>          the seed of the test order (random)\n"
+               "  timer=tsc|clock        the time stamp counter if it is "
+               "invariant (tsc)\n"
+               "  isa=v1|v2|v3|v4|best   the x86-64 level of the compute "
+               "kernels (best)\n"
+               "  format=text|json|csv   what goes to standard output (text)\n"
+               "  json=<file>            also write the results as JSON\n"
+               "  csv=<file>             also write the results as CSV\n"
+               "  perf                   read hardware performance counters\n"
+               "  latency                time every iteration\n"
+               "  none, compact, scatter, physical, smt-pairs\n"
+               "                         where to pin the threads (none)\n"
+               "  help                   print this and stop\n";
+    }
+
+    std::string list_comparison (
+            markbench::compare::result_file const               &baseline,
+            markbench::compare::result_file const               &current,
+            std::vector< markbench::compare::comparison > const &changes )
+            override final
+    {
+        using markbench::compare::verdict;
+        std::string result = "Comparing " + current.hostname + " at "
+                           + current.timestamp + " against "
+                           + baseline.hostname + " at " + baseline.timestamp
+                           + " (suite " + current.suite + ")\n";
+        if ( changes.empty ( ) )
+        {
+            return result + "The two files have no tests in common.\n";
+        }
+        for ( auto const &c : changes )
+        {
+            result += c.test + " on " + std::to_string ( c.threads )
+                    + " threads: " + significant ( c.baseline_mean ) + " -> "
+                    + significant ( c.current_mean ) + " rhedstones";
+            switch ( c.outcome )
+            {
+                case verdict::unchanged: result += ", unchanged"; break;
+                case verdict::improved: result += ", IMPROVED"; break;
+                case verdict::regressed: result += ", REGRESSED"; break;
+                case verdict::inconclusive:
+                    result += ", too few trials to tell";
+                    break;
+            }
+            result += "\n\t- change: "
+                    + significant ( c.change * 100 ) + "%, Welch's t p = "
+                    + significant ( c.welch.p_value ) + ", Mann-Whitney U p = "
+                    + significant ( c.mann_whitney.p_value )
+                    + ", Hedges' g = " + significant ( c.effect_size ) + "\n";
+        }
         return result;
     }
 };
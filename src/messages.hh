@@ -13,7 +13,13 @@
  */
 #pragma once
 
+#include "compare.hh"
+#include "memory-latency.hh"
+#include "statistics.hh"
 #include "test.hh"
+#include "thermal.hh"
+#include "timing.hh"
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -24,10 +30,59 @@ public:
             test_message ( std::string const             &id,
                            markbench::thread_count const &count ) = 0;
     virtual std::string
-            list_results ( markbench::test_counters const &results ) = 0;
+            list_results ( markbench::test_result const &results ) = 0;
+    virtual std::string list_statistics (
+            markbench::statistics::summary const &trials ) = 0;
+    virtual std::string list_latency (
+            markbench::latency::distribution const &latencies ) = 0;
+    // empty if neither the clocks nor the temperatures could be read.
+    virtual std::string
+            list_clocks ( markbench::thermal::summary const &clocks ) = 0;
+    // for tests of single instructions. The clock is NaN if unknown.
+    virtual std::string
+            list_instructions ( long double const &per_cycle,
+                                long double const &gigahertz ) = 0;
+    virtual std::string
+            list_load_latency ( long double const &nanoseconds ) = 0;
+    virtual std::string
+            list_bandwidth ( long double const &gigabytes_per_second,
+                             long double const &bytes_per_cycle ) = 0;
+    // the rungs are in order.
+    virtual std::string list_ladder (
+            std::vector< markbench::memory_latency::rung > const &rungs ) = 0;
+    // usual is the median clock of the other passes on the given number of
+    // threads.
+    virtual std::string
+            throttle_message ( long double const             &megahertz,
+                               long double const             &usual,
+                               markbench::thread_count const &threads,
+                               bool const                    &rerunning ) = 0;
+    // knee is the index of the last point that still scaled well.
+    virtual std::string
+            list_scaling ( std::string const                             &id,
+                           std::vector< markbench::scaling_point > const &points,
+                           std::size_t const &knee ) = 0;
+    // the errors are the half-widths of the 95% confidence intervals.
     virtual std::string list_rhedstone_count (
             std::vector< long double > const &single,
-            std::vector< long double > const &multi ) = 0;
+            std::vector< long double > const &multi,
+            long double const                &single_error,
+            long double const                &multi_error ) = 0;
+    // the test will not run, so it is not in the scores.
+    virtual std::string skip_message ( std::string const &id,
+                                       std::string const &reason ) = 0;
+    virtual std::string
+            timer_message ( markbench::timing::calibration const &clock ) = 0;
+    // the x86-64 level the compute kernels were built for, e.g.,
+    // "x86-64-v3".
+    virtual std::string isa_message ( std::string const &level ) = 0;
+    // the seed that the tests were shuffled with, to repeat the order.
+    virtual std::string shuffle_message ( std::uintmax_t const &seed ) = 0;
+    virtual std::string usage ( std::string const &program ) = 0;
+    virtual std::string list_comparison (
+            markbench::compare::result_file const               &baseline,
+            markbench::compare::result_file const               &current,
+            std::vector< markbench::compare::comparison > const &changes ) = 0;
 };
 
 // different locales
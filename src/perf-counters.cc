@@ -0,0 +1,261 @@
+/**
+ * @file perf-counters.cc
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Reads the hardware performance counters through perf_event_open.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+
+#include "perf-counters.hh"
+
+#if defined( LINUX )
+#    include <linux/perf_event.h>
+#    include <sys/ioctl.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+
+#include <cmath>
+#include <vector>
+
+namespace perf = markbench::perf;
+
+std::string perf::event_name ( event const e )
+{
+    switch ( e )
+    {
+        case cycles: return "cycles";
+        case instructions: return "instructions";
+        case branch_misses: return "branch misses";
+        case l1d_loads: return "L1D loads";
+        case l1d_misses: return "L1D misses";
+        case llc_references: return "LLC references";
+        case llc_misses: return "LLC misses";
+        case dtlb_misses: return "dTLB misses";
+        default: return "?";
+    }
+}
+
+bool perf::readings::any ( ) const noexcept
+{
+    for ( auto const &v : valid )
+    {
+        if ( v )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+perf::readings &perf::readings::operator+= ( readings const &that )
+{
+    for ( std::size_t i = 0; i < event_count; i++ )
+    {
+        // a thread that could not count an event makes the sum meaningless.
+        valid [ i ] = valid [ i ] && that.valid [ i ];
+        values [ i ] += that.values [ i ];
+    }
+    iterations += that.iterations;
+    return *this;
+}
+
+long double perf::readings::ratio ( event const numerator,
+                                    event const denominator ) const
+{
+    if ( !valid [ numerator ] || !valid [ denominator ]
+         || values [ denominator ] == 0 )
+    {
+        return std::nanl ( "" );
+    }
+    return values [ numerator ] / values [ denominator ];
+}
+
+long double perf::readings::per_kilo_instruction ( event const e ) const
+{
+    return 1000 * ratio ( e, instructions );
+}
+
+long double perf::readings::per_iteration ( event const e ) const
+{
+    if ( !valid [ e ] || iterations == 0 )
+    {
+        return std::nanl ( "" );
+    }
+    return values [ e ] / iterations;
+}
+
+#if defined( LINUX )
+/**
+ * @brief Opens one event for the calling thread on whichever CPU it runs on.
+ * @param leader the group to join, or -1 to start a new group.
+ */
+static int open_event ( perf::event const e, int const leader )
+{
+    static constexpr std::uint64_t read_access =
+            ( PERF_COUNT_HW_CACHE_OP_READ << 8 )
+            | ( PERF_COUNT_HW_CACHE_RESULT_ACCESS << 16 );
+    static constexpr std::uint64_t read_miss =
+            ( PERF_COUNT_HW_CACHE_OP_READ << 8 )
+            | ( PERF_COUNT_HW_CACHE_RESULT_MISS << 16 );
+
+    perf_event_attr attributes { };
+    attributes.size = sizeof ( attributes );
+    switch ( e )
+    {
+        case perf::cycles:
+            attributes.type   = PERF_TYPE_HARDWARE;
+            attributes.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case perf::instructions:
+            attributes.type   = PERF_TYPE_HARDWARE;
+            attributes.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case perf::branch_misses:
+            attributes.type   = PERF_TYPE_HARDWARE;
+            attributes.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        case perf::l1d_loads:
+            attributes.type   = PERF_TYPE_HW_CACHE;
+            attributes.config = PERF_COUNT_HW_CACHE_L1D | read_access;
+            break;
+        case perf::l1d_misses:
+            attributes.type   = PERF_TYPE_HW_CACHE;
+            attributes.config = PERF_COUNT_HW_CACHE_L1D | read_miss;
+            break;
+        case perf::llc_references:
+            attributes.type   = PERF_TYPE_HARDWARE;
+            attributes.config = PERF_COUNT_HW_CACHE_REFERENCES;
+            break;
+        case perf::llc_misses:
+            attributes.type   = PERF_TYPE_HARDWARE;
+            attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+            break;
+        case perf::dtlb_misses:
+            attributes.type   = PERF_TYPE_HW_CACHE;
+            attributes.config = PERF_COUNT_HW_CACHE_DTLB | read_miss;
+            break;
+        default: return -1;
+    }
+    // the leader starts disabled and the rest of the group follows it.
+    attributes.disabled       = leader == -1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv     = 1;
+    attributes.read_format    = PERF_FORMAT_GROUP
+                           | PERF_FORMAT_TOTAL_TIME_ENABLED
+                           | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return syscall ( SYS_perf_event_open,
+                     &attributes,
+                     0,
+                     -1,
+                     leader,
+                     PERF_FLAG_FD_CLOEXEC );
+}
+#endif
+
+perf::thread_counters::thread_counters ( )
+{
+    descriptors.fill ( -1 );
+    leaders.fill ( -1 );
+#if defined( LINUX )
+    // each miss shares a group with its accesses, so that a miss rate is
+    // counted over the same stretch of time whatever the multiplexing.
+    static std::array< std::vector< event >, groups > const layout = { {
+            { cycles, instructions, branch_misses },
+            { l1d_loads, l1d_misses, dtlb_misses },
+            { llc_references, llc_misses },
+    } };
+
+    for ( std::size_t g = 0; g < groups; g++ )
+    {
+        for ( auto const e : layout [ g ] )
+        {
+            int const descriptor = open_event ( e, leaders [ g ] );
+            if ( descriptor < 0 )
+            {
+                continue;
+            }
+            if ( leaders [ g ] < 0 )
+            {
+                leaders [ g ] = descriptor;
+            }
+            descriptors [ e ]                     = descriptor;
+            members [ g ][ member_count [ g ]++ ] = e;
+        }
+    }
+#endif
+}
+
+perf::thread_counters::~thread_counters ( )
+{
+#if defined( LINUX )
+    for ( auto const descriptor : descriptors )
+    {
+        if ( descriptor >= 0 )
+        {
+            close ( descriptor );
+        }
+    }
+#endif
+}
+
+void perf::thread_counters::start ( )
+{
+#if defined( LINUX )
+    for ( auto const leader : leaders )
+    {
+        if ( leader >= 0 )
+        {
+            ioctl ( leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP );
+            ioctl ( leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP );
+        }
+    }
+#endif
+}
+
+void perf::thread_counters::stop ( )
+{
+#if defined( LINUX )
+    for ( auto const leader : leaders )
+    {
+        if ( leader >= 0 )
+        {
+            ioctl ( leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP );
+        }
+    }
+#endif
+}
+
+perf::readings perf::thread_counters::read ( ) const
+{
+    readings result;
+    result.attempted = true;
+#if defined( LINUX )
+    for ( std::size_t g = 0; g < groups; g++ )
+    {
+        if ( leaders [ g ] < 0 )
+        {
+            continue;
+        }
+        // number of events, time enabled, time running, then the values.
+        std::array< std::uint64_t, 3 + event_count > buffer { };
+        if ( ::read ( leaders [ g ], buffer.data ( ), sizeof ( buffer ) ) <= 0
+             || buffer [ 2 ] == 0 )
+        {
+            continue;
+        }
+        long double const scale = ( long double ) buffer [ 1 ] / buffer [ 2 ];
+        for ( std::size_t i = 0; i < buffer [ 0 ] && i < member_count [ g ];
+              i++ )
+        {
+            result.values [ members [ g ][ i ] ] = buffer [ 3 + i ] * scale;
+            result.valid [ members [ g ][ i ] ]  = true;
+        }
+    }
+#endif
+    return result;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file perf-counters.hh
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Hardware performance counters, so that a score can come with a reason.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace markbench::perf
+{
+    enum event : std::size_t
+    {
+        cycles,
+        instructions,
+        branch_misses,
+        l1d_loads,
+        l1d_misses,
+        llc_references,
+        llc_misses,
+        dtlb_misses,
+        event_count,
+    };
+
+    std::string event_name ( event const e );
+
+    /**
+     * @brief Counter values, already scaled up for any time the kernel had
+     * the counters multiplexed out.
+     */
+    struct readings
+    {
+        std::array< long double, event_count > values { };
+        // false for every event the kernel would not let us count.
+        std::array< bool, event_count >        valid { };
+        // test iterations completed while counting.
+        std::uintmax_t                         iterations = 0;
+        // whether anybody tried to count at all.
+        bool                                   attempted  = false;
+
+        bool any ( ) const noexcept;
+
+        /**
+         * @brief Adds another thread's readings. An event stays valid only if
+         * both threads counted it.
+         */
+        readings &operator+= ( readings const &that );
+
+        /**
+         * @brief The ratio of two events, or NaN if either was not counted.
+         */
+        long double ratio ( event const numerator,
+                            event const denominator ) const;
+
+        /**
+         * @brief Events per thousand instructions, or NaN.
+         */
+        long double per_kilo_instruction ( event const e ) const;
+
+        /**
+         * @brief Events per test iteration, or NaN.
+         */
+        long double per_iteration ( event const e ) const;
+    };
+
+    /**
+     * @brief The counters for the calling thread. Opened with
+     * perf_event_open(2) in three groups ({cycles, instructions, branch
+     * misses}, {L1D loads, L1D read misses, dTLB read misses} and {LLC
+     * references, LLC misses}) so that each group fits in the counters that
+     * every x86 core has, and each miss rate comes from a single group.
+     * Anything that fails to open (no permission, a virtual machine with no
+     * PMU, not Linux) is simply not counted.
+     * @note Only counts user-space events so that it works with the default
+     * perf_event_paranoid of 2.
+     */
+    class thread_counters
+    {
+        static constexpr std::size_t groups = 3;
+
+        std::array< int, event_count >    descriptors;
+        std::array< int, groups >         leaders;
+        // the events in each group, in the order the kernel reports them.
+        std::array< std::array< event, event_count >, groups > members { };
+        std::array< std::size_t, groups > member_count { };
+    public:
+        thread_counters ( );
+        ~thread_counters ( );
+
+        thread_counters ( thread_counters const & )            = delete;
+        thread_counters &operator= ( thread_counters const & ) = delete;
+
+        void start ( );
+        void stop ( );
+
+        readings read ( ) const;
+    };
+} // namespace markbench::perf
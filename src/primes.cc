@@ -0,0 +1,185 @@
+/**
+ * @file primes.cc
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief The segmented prime sieve tests and the runs that threads share.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+
+#include "primes.hh"
+#include "isa-dispatch.hh"
+#include "test-utils.hh"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace isa    = markbench::isa;
+namespace primes = markbench::primes;
+
+namespace
+{
+    void validate ( std::uint64_t const limit, std::uint64_t const count )
+    {
+        if ( !isa::valid_prime_count ( limit, count ) )
+        {
+            throw std::logic_error ( "The segmented sieve counted "
+                                     + std::to_string ( count )
+                                     + " primes below "
+                                     + std::to_string ( limit ) );
+        }
+    }
+
+    /**
+     * @brief The per-thread fixture of a replica test: the thread's own plan
+     * and segment, and every segment of the range each iteration.
+     */
+    template < std::uint64_t limit > class replica
+    {
+        isa::sieve_plan              plan;
+        std::vector< std::uint64_t > bits;
+    public:
+        replica ( ) :
+                plan { isa::make_sieve_plan ( limit ) },
+                bits ( isa::sieve_segment_words )
+        { }
+
+        void operator( ) ( )
+        {
+            std::uint64_t count = 0;
+            for ( std::uint64_t s = 0; s < plan.segments; s++ )
+            {
+                count += isa::sieve_segment ( plan, s, bits.data ( ) );
+            }
+            validate ( limit, count );
+        }
+    };
+
+    /**
+     * @brief A range that every thread of a cooperative test sieves together.
+     * Tickets are handed out in order: ticket t is segment t % segments of
+     * run t / segments. A slow thread can still be finishing a run after the
+     * others have moved on, so each run keeps its own tally.
+     */
+    class shared_range
+    {
+        struct tally
+        {
+            std::uint64_t primes   = 0;
+            std::uint64_t segments = 0;
+        };
+
+        std::atomic_uint64_t             tickets { 0 };
+        std::mutex                       tallying;
+        std::map< std::uint64_t, tally > runs;
+    public:
+        isa::sieve_plan const plan;
+
+        explicit shared_range ( std::uint64_t const limit ) :
+                plan { isa::make_sieve_plan ( limit ) }
+        { }
+
+        std::uint64_t take ( )
+        {
+            return tickets.fetch_add ( 1, std::memory_order_relaxed );
+        }
+
+        /**
+         * @brief Sieves the rest of the run the pass stopped in, if it stopped
+         * partway through one, or that run would never be checked. Each
+         * stopped thread helps, and none goes on into the next run.
+         */
+        void finish ( std::uint64_t *const bits )
+        {
+            std::uint64_t ticket = tickets.load ( std::memory_order_relaxed );
+            while ( ticket % plan.segments != 0 )
+            {
+                // on failure, ticket is reloaded with whichever is next.
+                if ( tickets.compare_exchange_weak (
+                             ticket, ticket + 1, std::memory_order_relaxed ) )
+                {
+                    record ( ticket,
+                             isa::sieve_segment ( plan,
+                                                  ticket % plan.segments,
+                                                  bits ) );
+                    ticket++;
+                }
+            }
+        }
+
+        /**
+         * @brief Adds a segment's primes to its run, and checks the run's
+         * count once that was its last segment.
+         */
+        void record ( std::uint64_t const ticket, std::uint64_t const primes )
+        {
+            std::uint64_t const run = ticket / plan.segments;
+            std::uint64_t       total;
+            {
+                std::scoped_lock lock { tallying };
+                tally           &t = runs [ run ];
+                t.primes += primes;
+                if ( ++t.segments < plan.segments )
+                {
+                    return;
+                }
+                total = t.primes;
+                runs.erase ( run );
+            }
+            validate ( plan.limit, total );
+        }
+    };
+
+    /**
+     * @brief The per-thread fixture of a cooperative test: the shared range,
+     * the thread's own segment, and one segment of the range each iteration.
+     */
+    template < std::uint64_t limit > class cooperative
+    {
+        std::shared_ptr< shared_range > range;
+        std::vector< std::uint64_t >    bits;
+    public:
+        cooperative ( ) :
+                range { shared_per_pass< shared_range > ( limit ) },
+                bits ( isa::sieve_segment_words )
+        { }
+
+        void operator( ) ( )
+        {
+            std::uint64_t const ticket = range->take ( );
+            range->record ( ticket,
+                            isa::sieve_segment ( range->plan,
+                                                 ticket % range->plan.segments,
+                                                 bits.data ( ) ) );
+        }
+
+        void finish ( ) { range->finish ( bits.data ( ) ); }
+    };
+
+    template < template < std::uint64_t > class fixture, std::uint64_t limit >
+    individual_test sieve_test ( std::string const &mode )
+    {
+        return fixture_test< fixture< limit > > (
+                "test.primes." + mode + "." + std::to_string ( limit ) );
+    }
+} // namespace
+
+test_suite primes::suite ( )
+{
+    return {
+            sieve_test< replica, 1000000 > ( "replica" ),
+            sieve_test< replica, 100000000 > ( "replica" ),
+            sieve_test< cooperative, 100000000 > ( "cooperative" ),
+            sieve_test< cooperative, 1000000000 > ( "cooperative" ),
+            sieve_test< cooperative, 10000000000 > ( "cooperative" ),
+    };
+}
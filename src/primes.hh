@@ -0,0 +1,36 @@
+/**
+ * @file primes.hh
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief The segmented prime sieve tests, with every thread sieving a range
+ * of its own or all of them sieving one range together.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+#pragma once
+
+#include "test-suite.hh"
+
+namespace markbench::primes
+{
+    /**
+     * @brief The sieve of isa::sieve_segment, run two ways:
+     *
+     * test.primes.replica.<limit>: each iteration sieves every number below
+     * the limit, on each thread, as test.davidpl_primes_sieve does.
+     *
+     * test.primes.cooperative.<limit>: the threads share one sieve of the
+     * numbers below the limit, and each iteration sieves whichever of its
+     * segments is next. Once every segment of a run is done, the next run
+     * starts over. The run a pass stops in is finished by the threads once
+     * they stop, outside the timing.
+     *
+     * Either way, every run's count of primes is checked against the known
+     * one, and a wrong count throws std::logic_error, which ends the program,
+     * or the pass, if it is isolated.
+     */
+    test_suite suite ( );
+} // namespace markbench::primes
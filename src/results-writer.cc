@@ -0,0 +1,431 @@
+/**
+ * @file results-writer.cc
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief JSON and CSV results.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+
+#include "results-writer.hh"
+
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+
+namespace results = markbench::results;
+
+/**
+ * @brief The rates we derive from a trial's counters and duration.
+ */
+struct rates
+{
+    long double iterations;
+    // iterations per nanosecond over all threads.
+    long double rhedstones;
+    long double iterations_per_second;
+    // nanoseconds per iteration on each thread.
+    long double ns_per_iteration;
+    // ns_per_iteration less the empty loop. NaN if unknown.
+    long double corrected_ns_per_iteration;
+};
+
+static rates rates_of ( markbench::test_result const &r )
+{
+    rates result { };
+    for ( auto const &c : r.counters ) { result.iterations += c; }
+    std::chrono::duration< long double, std::nano > const elapsed = r.elapsed;
+    result.rhedstones            = result.iterations / elapsed.count ( );
+    result.iterations_per_second = result.rhedstones * 1e9L;
+    result.ns_per_iteration      = elapsed.count ( ) * r.counters.size ( )
+                            / result.iterations;
+    result.corrected_ns_per_iteration =
+            r.loop_overhead > 0 ? result.ns_per_iteration - r.loop_overhead
+                                : std::nanl ( "" );
+    return result;
+}
+
+/**
+ * @brief Just enough of a JSON writer: it keeps track of commas and
+ * indentation so that the code below reads like the document it writes.
+ */
+class json_writer
+{
+    std::ostream &out;
+    std::size_t   depth = 0;
+    // whether the next value in the current object or array needs a comma.
+    bool          comma = false;
+    // whether a key was just written, so the value goes on the same line.
+    bool          keyed = false;
+
+    void separate ( )
+    {
+        if ( keyed )
+        {
+            keyed = false;
+            return;
+        }
+        if ( comma )
+        {
+            out << ",";
+        }
+        if ( depth )
+        {
+            out << "\n" << std::string ( 2 * depth, ' ' );
+        }
+    }
+public:
+    explicit json_writer ( std::ostream &out ) : out { out } { }
+
+    static std::string quote ( std::string const &text )
+    {
+        std::string result = "\"";
+        for ( char const c : text )
+        {
+            switch ( c )
+            {
+                case '"': result += "\\\""; break;
+                case '\\': result += "\\\\"; break;
+                case '\n': result += "\\n"; break;
+                case '\t': result += "\\t"; break;
+                default:
+                    if ( ( unsigned char ) c < 0x20 )
+                    {
+                        char escaped [ 8 ];
+                        std::snprintf ( escaped,
+                                        sizeof ( escaped ),
+                                        "\\u%04x",
+                                        ( unsigned ) c );
+                        result += escaped;
+                    } else
+                    {
+                        result += c;
+                    }
+            }
+        }
+        return result + "\"";
+    }
+
+    void open ( char const bracket )
+    {
+        separate ( );
+        out << bracket;
+        depth++;
+        comma = false;
+    }
+
+    void close ( char const bracket )
+    {
+        depth--;
+        out << "\n" << std::string ( 2 * depth, ' ' ) << bracket;
+        comma = true;
+    }
+
+    json_writer &key ( std::string const &name )
+    {
+        separate ( );
+        out << quote ( name ) << ": ";
+        keyed = true;
+        comma = true;
+        return *this;
+    }
+
+    void raw ( std::string const &text )
+    {
+        separate ( );
+        out << text;
+        comma = true;
+    }
+
+    void value ( std::string const &text ) { raw ( quote ( text ) ); }
+
+    void value ( char const *const text ) { raw ( quote ( text ) ); }
+
+    void value ( bool const b ) { raw ( b ? "true" : "false" ); }
+
+    // JSON has no NaN or infinity, so those are null.
+    void value ( long double const x )
+    {
+        if ( !std::isfinite ( x ) )
+        {
+            raw ( "null" );
+            return;
+        }
+        std::ostringstream stream;
+        stream << std::setprecision ( 17 ) << x;
+        raw ( stream.str ( ) );
+    }
+
+    template < typename integer >
+        requires std::is_integral_v< integer >
+    void value ( integer const i )
+    {
+        raw ( std::to_string ( i ) );
+    }
+
+    template < typename T > void field ( std::string const &name, T const &x )
+    {
+        key ( name ).value ( x );
+    }
+};
+
+static void write_host ( json_writer                        &json,
+                         markbench::host::description const &host )
+{
+    json.key ( "host" ).open ( '{' );
+    json.field ( "cpu_model", host.cpu_model );
+    json.field ( "logical_cpus", host.logical_cpus );
+    json.field ( "physical_cores", host.physical_cores );
+    json.field ( "packages", host.packages );
+    json.field ( "kernel", host.kernel );
+    json.field ( "hostname", host.hostname );
+    json.field ( "compiler", host.compiler );
+    json.field ( "flags", host.flags );
+    json.field ( "timestamp", host.timestamp );
+    json.field ( "timer", host.timer );
+    json.field ( "timer_ghz", host.timer_ghz );
+    json.field ( "timer_overhead_ns", host.timer_overhead_ns );
+    json.field ( "isa", host.isa );
+    json.close ( '}' );
+}
+
+static void write_trial ( json_writer                  &json,
+                          markbench::test_result const &trial,
+                          bool const                    rejected )
+{
+    rates const r = rates_of ( trial );
+    json.open ( '{' );
+    json.field ( "rejected", rejected );
+    json.key ( "counters" ).open ( '[' );
+    for ( auto const &c : trial.counters ) { json.value ( c ); }
+    json.close ( ']' );
+    json.field ( "elapsed_ns",
+                 std::chrono::duration_cast< std::chrono::nanoseconds > (
+                         trial.elapsed )
+                         .count ( ) );
+    json.field ( "windows", trial.windows );
+    json.field ( "relative_error", trial.relative_error );
+    json.field ( "iterations", r.iterations );
+    json.field ( "rhedstones", r.rhedstones );
+    json.field ( "iterations_per_second", r.iterations_per_second );
+    json.field ( "ns_per_iteration", r.ns_per_iteration );
+    json.field ( "loop_overhead_ns", trial.loop_overhead );
+    json.field ( "corrected_ns_per_iteration", r.corrected_ns_per_iteration );
+    if ( !trial.placement.empty ( ) )
+    {
+        json.key ( "placement" ).open ( '[' );
+        for ( auto const &cpu : trial.placement ) { json.value ( cpu ); }
+        json.close ( ']' );
+    }
+    if ( trial.events.attempted )
+    {
+        using namespace markbench::perf;
+        json.key ( "events" ).open ( '{' );
+        for ( std::size_t e = 0; e < event_count; e++ )
+        {
+            json.key ( event_name ( event ( e ) ) );
+            if ( trial.events.valid [ e ] )
+            {
+                json.value ( trial.events.values [ e ] );
+            } else
+            {
+                json.raw ( "null" );
+            }
+        }
+        json.field ( "instructions_per_cycle",
+                     trial.events.ratio ( instructions, cycles ) );
+        json.field ( "l1d_miss_rate",
+                     trial.events.ratio ( l1d_misses, l1d_loads ) );
+        json.field ( "llc_miss_rate",
+                     trial.events.ratio ( llc_misses, llc_references ) );
+        json.close ( '}' );
+    }
+    json.close ( '}' );
+}
+
+static void write_latencies ( json_writer                            &json,
+                              markbench::latency::distribution const &l )
+{
+    json.key ( "latency_ns" ).open ( '{' );
+    json.field ( "count", l.count ( ) );
+    json.field ( "p50", l.percentile ( 0.50L ) );
+    json.field ( "p90", l.percentile ( 0.90L ) );
+    json.field ( "p99", l.percentile ( 0.99L ) );
+    json.field ( "p99.9", l.percentile ( 0.999L ) );
+    json.field ( "max", l.maximum ( ) );
+    json.close ( '}' );
+}
+
+void results::write_json ( std::ostream &out, run_report const &report )
+{
+    json_writer json { out };
+    json.open ( '{' );
+    json.field ( "format_version", format_version );
+    json.field ( "suite", report.suite );
+    write_host ( json, report.host );
+
+    json.key ( "score" ).open ( '{' );
+    json.field ( "single_threaded", report.single_score );
+    json.field ( "single_threaded_error", report.single_error );
+    json.field ( "multi_threaded", report.multi_score );
+    json.field ( "multi_threaded_error", report.multi_error );
+    json.close ( '}' );
+
+    json.key ( "passes" ).open ( '[' );
+    for ( auto const &pass : report.passes )
+    {
+        auto const &s = pass.summary;
+        json.open ( '{' );
+        json.field ( "test", pass.id );
+        json.field ( "threads", pass.threads );
+        json.field ( "placement",
+                     markbench::topology::policy_name ( pass.placement ) );
+        json.key ( "rhedstones" ).open ( '{' );
+        json.field ( "trials", s.count );
+        json.field ( "rejected", s.rejected );
+        json.field ( "mean", s.mean );
+        json.field ( "median", s.median );
+        json.field ( "standard_deviation", s.standard_deviation );
+        json.field ( "minimum", s.minimum );
+        json.field ( "maximum", s.maximum );
+        json.field ( "confidence_low", s.confidence_low );
+        json.field ( "confidence_high", s.confidence_high );
+        json.close ( '}' );
+        if ( !pass.latencies.empty ( ) )
+        {
+            write_latencies ( json, pass.latencies );
+        }
+        if ( !std::isnan ( pass.nanoseconds_per_load ) )
+        {
+            json.field ( "ns_per_load", pass.nanoseconds_per_load );
+        }
+        if ( !std::isnan ( pass.gigabytes_per_second ) )
+        {
+            json.field ( "gb_per_second", pass.gigabytes_per_second );
+            json.field ( "bytes_per_cycle", pass.bytes_per_cycle );
+        }
+        if ( !std::isnan ( pass.instructions_per_cycle ) )
+        {
+            json.key ( "instructions" ).open ( '{' );
+            json.field ( "per_cycle", pass.instructions_per_cycle );
+            json.field ( "core_ghz", pass.core_gigahertz );
+            json.close ( '}' );
+        }
+        json.key ( "clock" ).open ( '{' );
+        json.field ( "samples", pass.clocks.samples );
+        json.field ( "mean_mhz", pass.clocks.mean_megahertz );
+        json.field ( "minimum_mhz", pass.clocks.minimum_megahertz );
+        json.field ( "maximum_celsius", pass.clocks.maximum_celsius );
+        json.field ( "throttled", pass.throttled );
+        json.field ( "rerun", pass.rerun );
+        json.close ( '}' );
+        json.key ( "trials" ).open ( '[' );
+        for ( std::size_t i = 0; i < pass.trials.size ( ); i++ )
+        {
+            write_trial ( json, pass.trials [ i ], pass.rejected [ i ] );
+        }
+        json.close ( ']' );
+        json.close ( '}' );
+    }
+    json.close ( ']' );
+
+    json.key ( "skipped" ).open ( '[' );
+    for ( auto const &skip : report.skipped )
+    {
+        json.open ( '{' );
+        json.field ( "test", skip.id );
+        json.field ( "reason", skip.reason );
+        json.close ( '}' );
+    }
+    json.close ( ']' );
+    json.close ( '}' );
+    out << "\n";
+}
+
+/**
+ * @brief Quotes a CSV field if it needs it.
+ */
+static std::string csv_field ( std::string const &text )
+{
+    if ( text.find_first_of ( ",\"\n" ) == std::string::npos )
+    {
+        return text;
+    }
+    std::string result = "\"";
+    for ( char const c : text )
+    {
+        result += c == '"' ? std::string ( "\"\"" ) : std::string ( 1, c );
+    }
+    return result + "\"";
+}
+
+static std::string csv_number ( long double const x )
+{
+    if ( !std::isfinite ( x ) )
+    {
+        return "";
+    }
+    std::ostringstream stream;
+    stream << std::setprecision ( 17 ) << x;
+    return stream.str ( );
+}
+
+void results::write_csv ( std::ostream &out, run_report const &report )
+{
+    auto const &host = report.host;
+    out << "format_version,suite,timestamp,hostname,cpu_model,logical_cpus,"
+           "physical_cores,packages,kernel,compiler,flags,test,threads,"
+           "placement,trial,rejected,elapsed_ns,windows,relative_error,"
+           "iterations,rhedstones,iterations_per_second,ns_per_iteration,"
+           "loop_overhead_ns,corrected_ns_per_iteration,counters,mean_mhz,"
+           "throttled,isa\n";
+
+    std::string const machine =
+            std::to_string ( format_version ) + ","
+            + csv_field ( report.suite ) + "," + csv_field ( host.timestamp )
+            + "," + csv_field ( host.hostname ) + ","
+            + csv_field ( host.cpu_model ) + ","
+            + std::to_string ( host.logical_cpus ) + ","
+            + std::to_string ( host.physical_cores ) + ","
+            + std::to_string ( host.packages ) + "," + csv_field ( host.kernel )
+            + "," + csv_field ( host.compiler ) + ","
+            + csv_field ( host.flags );
+
+    for ( auto const &pass : report.passes )
+    {
+        for ( std::size_t i = 0; i < pass.trials.size ( ); i++ )
+        {
+            auto const &trial = pass.trials [ i ];
+            rates const r     = rates_of ( trial );
+            std::string counters;
+            for ( auto const &c : trial.counters )
+            {
+                counters += ( counters.empty ( ) ? "" : ";" )
+                          + std::to_string ( c );
+            }
+            out << machine << "," << csv_field ( pass.id ) << ","
+                << pass.threads << ","
+                << markbench::topology::policy_name ( pass.placement ) << ","
+                << i << "," << ( pass.rejected [ i ] ? 1 : 0 ) << ","
+                << std::chrono::duration_cast< std::chrono::nanoseconds > (
+                           trial.elapsed )
+                           .count ( )
+                << "," << trial.windows << ","
+                << csv_number ( trial.relative_error ) << ","
+                << csv_number ( r.iterations ) << ","
+                << csv_number ( r.rhedstones ) << ","
+                << csv_number ( r.iterations_per_second ) << ","
+                << csv_number ( r.ns_per_iteration ) << ","
+                << csv_number ( trial.loop_overhead ) << ","
+                << csv_number ( r.corrected_ns_per_iteration ) << ","
+                << counters << ","
+                << csv_number ( pass.clocks.mean_megahertz ) << ","
+                << ( pass.throttled ? 1 : 0 ) << ","
+                << csv_field ( host.isa ) << "\n";
+        }
+    }
+}
@@ -0,0 +1,58 @@
+/**
+ * @file results-writer.hh
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Writes results out as JSON and CSV for other programs to read.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+#pragma once
+
+#include "host.hh"
+#include "test-runner.hh"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace markbench::results
+{
+    /**
+     * @brief Bumped whenever a field changes meaning or goes away, so that
+     * whatever reads the files can tell.
+     */
+    inline constexpr int format_version = 1;
+
+    /**
+     * @brief Everything about one run of markbench.
+     */
+    struct run_report
+    {
+        // the suite version that ran, e.g., "001".
+        std::string                 suite;
+        host::description           host;
+        std::vector< pass_record >  passes;
+        std::vector< skipped_test > skipped;
+        // the scores, as printed by list_rhedstone_count.
+        long double                 single_score = 0;
+        long double                 multi_score  = 0;
+        long double                 single_error = 0;
+        long double                 multi_error  = 0;
+    };
+
+    /**
+     * @brief One JSON document: the suite, the host, the scores, and every
+     * pass with every trial in it.
+     */
+    void write_json ( std::ostream &out, run_report const &report );
+
+    /**
+     * @brief One row per trial with the suite and host repeated on every row,
+     * so that each row stands on its own. Per-thread counters are joined with
+     * semicolons.
+     */
+    void write_csv ( std::ostream &out, run_report const &report );
+} // namespace markbench::results
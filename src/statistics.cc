@@ -0,0 +1,431 @@
+/**
+ * @file statistics.cc
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Implements the statistics.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+
+#include "statistics.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace stats = markbench::statistics;
+
+long double stats::mean ( samples const &x )
+{
+    if ( x.empty ( ) )
+    {
+        return 0;
+    }
+    return std::accumulate ( x.begin ( ), x.end ( ), 0.0L ) / x.size ( );
+}
+
+long double stats::variance ( samples const &x )
+{
+    if ( x.size ( ) < 2 )
+    {
+        return 0;
+    }
+    long double const m     = mean ( x );
+    long double       total = 0;
+    for ( auto const &v : x ) { total += ( v - m ) * ( v - m ); }
+    return total / ( x.size ( ) - 1 );
+}
+
+long double stats::standard_deviation ( samples const &x )
+{
+    return std::sqrt ( variance ( x ) );
+}
+
+long double stats::median ( samples x )
+{
+    if ( x.empty ( ) )
+    {
+        return 0;
+    }
+    std::sort ( x.begin ( ), x.end ( ) );
+    std::size_t const middle = x.size ( ) / 2;
+    return x.size ( ) % 2 ? x [ middle ]
+                          : ( x [ middle - 1 ] + x [ middle ] ) / 2;
+}
+
+std::vector< bool > stats::outliers ( samples const &x )
+{
+    // 1.4826 scales the median absolute deviation to the standard deviation
+    // for normally distributed data.
+    static constexpr long double scale  = 1.4826L;
+    static constexpr long double cutoff = 3;
+    // below five, the median absolute deviation is set by one or two gaps.
+    // Of three samples, one is the median and deviates by 0, so the spread
+    // is the smaller of the other two gaps, and a trial only somewhat slower
+    // than the rest is thrown out, which leaves two to summarize.
+    static constexpr std::size_t minimum_samples = 5;
+
+    std::vector< bool > result ( x.size ( ), false );
+    if ( x.size ( ) < minimum_samples )
+    {
+        return result;
+    }
+    long double const   center = median ( x );
+    samples             deviations;
+    for ( auto const &v : x ) { deviations.push_back ( std::fabs ( v - center ) ); }
+    long double const spread = scale * median ( deviations );
+    if ( spread <= 0 )
+    {
+        return result;
+    }
+    for ( std::size_t i = 0; i < x.size ( ); i++ )
+    {
+        result [ i ] = deviations [ i ] > cutoff * spread;
+    }
+    return result;
+}
+
+stats::summary stats::summarize ( samples const &x )
+{
+    summary result;
+    if ( x.empty ( ) )
+    {
+        return result;
+    }
+    auto const [ low, high ]  = std::minmax_element ( x.begin ( ), x.end ( ) );
+    long double const width   = confidence_half_width ( x );
+    result.count              = x.size ( );
+    result.mean               = mean ( x );
+    result.median             = median ( x );
+    result.standard_deviation = standard_deviation ( x );
+    result.minimum            = *low;
+    result.maximum            = *high;
+    result.confidence_low     = result.mean - width;
+    result.confidence_high    = result.mean + width;
+    return result;
+}
+
+/**
+ * @brief Continued fraction for the incomplete beta function, as in Numerical
+ * Recipes (modified Lentz's method).
+ */
+static long double beta_continued_fraction ( long double a,
+                                             long double b,
+                                             long double x )
+{
+    static constexpr int         max_iterations = 300;
+    static constexpr long double epsilon        = 1e-15L;
+    static constexpr long double tiny           = 1e-300L;
+
+    long double const qab = a + b;
+    long double const qap = a + 1;
+    long double const qam = a - 1;
+    long double       c   = 1;
+    long double       d   = 1 - qab * x / qap;
+    if ( std::fabs ( d ) < tiny )
+    {
+        d = tiny;
+    }
+    d             = 1 / d;
+    long double h = d;
+    for ( int m = 1; m <= max_iterations; m++ )
+    {
+        int const   m2 = 2 * m;
+        long double aa = m * ( b - m ) * x / ( ( qam + m2 ) * ( a + m2 ) );
+        d              = 1 + aa * d;
+        if ( std::fabs ( d ) < tiny )
+        {
+            d = tiny;
+        }
+        c = 1 + aa / c;
+        if ( std::fabs ( c ) < tiny )
+        {
+            c = tiny;
+        }
+        d = 1 / d;
+        h *= d * c;
+        aa = -( a + m ) * ( qab + m ) * x / ( ( a + m2 ) * ( qap + m2 ) );
+        d  = 1 + aa * d;
+        if ( std::fabs ( d ) < tiny )
+        {
+            d = tiny;
+        }
+        c = 1 + aa / c;
+        if ( std::fabs ( c ) < tiny )
+        {
+            c = tiny;
+        }
+        d                       = 1 / d;
+        long double const delta = d * c;
+        h *= delta;
+        if ( std::fabs ( delta - 1 ) < epsilon )
+        {
+            break;
+        }
+    }
+    return h;
+}
+
+/**
+ * @brief The regularized incomplete beta function I_x(a, b).
+ */
+static long double incomplete_beta ( long double a, long double b, long double x )
+{
+    if ( x <= 0 )
+    {
+        return 0;
+    }
+    if ( x >= 1 )
+    {
+        return 1;
+    }
+    long double const front =
+            std::exp ( std::lgamma ( a + b ) - std::lgamma ( a )
+                       - std::lgamma ( b ) + a * std::log ( x )
+                       + b * std::log ( 1 - x ) );
+    if ( x < ( a + 1 ) / ( a + b + 2 ) )
+    {
+        return front * beta_continued_fraction ( a, b, x ) / a;
+    }
+    return 1 - front * beta_continued_fraction ( b, a, 1 - x ) / b;
+}
+
+long double stats::student_t_cdf ( long double t,
+                                   long double degrees_of_freedom )
+{
+    long double const x    = degrees_of_freedom / ( degrees_of_freedom + t * t );
+    long double const tail = incomplete_beta ( degrees_of_freedom / 2, 0.5L, x )
+                           / 2;
+    return t > 0 ? 1 - tail : tail;
+}
+
+long double stats::student_t_quantile ( long double p,
+                                        long double degrees_of_freedom )
+{
+    if ( p <= 0 || p >= 1 || degrees_of_freedom <= 0 )
+    {
+        return std::nanl ( "" );
+    }
+    if ( p < 0.5L )
+    {
+        return -student_t_quantile ( 1 - p, degrees_of_freedom );
+    }
+    long double low  = 0;
+    long double high = 1;
+    while ( student_t_cdf ( high, degrees_of_freedom ) < p ) { high *= 2; }
+    for ( int i = 0; i < 200 && high - low > 1e-12L * high; i++ )
+    {
+        long double const middle = ( low + high ) / 2;
+        if ( student_t_cdf ( middle, degrees_of_freedom ) < p )
+        {
+            low = middle;
+        } else
+        {
+            high = middle;
+        }
+    }
+    return ( low + high ) / 2;
+}
+
+long double stats::confidence_half_width ( samples const &x, long double level )
+{
+    if ( x.size ( ) < 2 )
+    {
+        return std::numeric_limits< long double >::infinity ( );
+    }
+    long double const t =
+            student_t_quantile ( ( 1 + level ) / 2, x.size ( ) - 1 );
+    return t * standard_deviation ( x ) / std::sqrt ( ( long double ) x.size ( ) );
+}
+
+/**
+ * @brief 0, or infinity with the sign of x. What a statistic comes out to when
+ * there is no spread to divide by.
+ */
+static long double infinitely ( long double const x )
+{
+    return x == 0 ? 0
+                  : std::copysign (
+                            std::numeric_limits< long double >::infinity ( ),
+                            x );
+}
+
+stats::test_outcome stats::welch_t_test ( samples const &a, samples const &b )
+{
+    if ( a.size ( ) < 2 || b.size ( ) < 2 )
+    {
+        return { std::nanl ( "" ), std::nanl ( "" ) };
+    }
+    long double const va         = variance ( a ) / a.size ( );
+    long double const vb         = variance ( b ) / b.size ( );
+    long double const difference = mean ( b ) - mean ( a );
+    if ( va + vb <= 0 )
+    {
+        // no spread at all: either identical or certainly different.
+        return { infinitely ( difference ), difference == 0 ? 1.0L : 0.0L };
+    }
+    long double const t = difference / std::sqrt ( va + vb );
+    long double const degrees_of_freedom =
+            ( va + vb ) * ( va + vb )
+            / ( va * va / ( a.size ( ) - 1 ) + vb * vb / ( b.size ( ) - 1 ) );
+    return { t,
+             2 * student_t_cdf ( -std::fabs ( t ), degrees_of_freedom ) };
+}
+
+/**
+ * @brief The number of ways that m samples from one side and n from the other
+ * can be ordered so that U comes out to each value from 0 to m n, assuming no
+ * ties. Built up one sample at a time.
+ */
+static std::vector< long double > u_distribution ( std::size_t const m,
+                                                   std::size_t const n )
+{
+    // ways [ i ][ j ][ u ] for i samples on one side and j on the other,
+    // keeping only the current i.
+    std::vector< std::vector< long double > > previous ( n + 1 );
+    for ( std::size_t j = 0; j <= n; j++ ) { previous [ j ] = { 1 }; }
+    for ( std::size_t i = 1; i <= m; i++ )
+    {
+        std::vector< std::vector< long double > > current ( n + 1 );
+        current [ 0 ] = { 1 };
+        for ( std::size_t j = 1; j <= n; j++ )
+        {
+            current [ j ].assign ( i * j + 1, 0 );
+            // the largest sample is either one of the i, which beats all j
+            // of the others, or one of the j, which beats nobody.
+            for ( std::size_t u = 0; u < previous [ j ].size ( ); u++ )
+            {
+                current [ j ][ u + j ] += previous [ j ][ u ];
+            }
+            for ( std::size_t u = 0; u < current [ j - 1 ].size ( ); u++ )
+            {
+                current [ j ][ u ] += current [ j - 1 ][ u ];
+            }
+        }
+        previous = std::move ( current );
+    }
+    return previous [ n ];
+}
+
+stats::test_outcome stats::mann_whitney_u_test ( samples const &a,
+                                                 samples const &b )
+{
+    // past this, the normal approximation is good enough.
+    static constexpr std::size_t exact_limit = 50;
+
+    if ( a.empty ( ) || b.empty ( ) )
+    {
+        return { std::nanl ( "" ), std::nanl ( "" ) };
+    }
+    std::size_t const m = a.size ( );
+    std::size_t const n = b.size ( );
+
+    // rank everything together, ties getting the average of their ranks.
+    std::vector< std::pair< long double, bool > > all;
+    for ( auto const &x : a ) { all.push_back ( { x, true } ); }
+    for ( auto const &x : b ) { all.push_back ( { x, false } ); }
+    std::sort ( all.begin ( ), all.end ( ) );
+    long double rank_sum = 0;
+    long double tie_term = 0;
+    bool        any_ties = false;
+    for ( std::size_t i = 0; i < all.size ( ); )
+    {
+        std::size_t j = i;
+        while ( j < all.size ( ) && all [ j ].first == all [ i ].first )
+        {
+            j++;
+        }
+        long double const rank  = ( i + 1 + j ) / 2.0L;
+        long double const count = j - i;
+        for ( std::size_t k = i; k < j; k++ )
+        {
+            rank_sum += all [ k ].second ? rank : 0;
+        }
+        tie_term += count * count * count - count;
+        any_ties |= count > 1;
+        i = j;
+    }
+    long double const u      = rank_sum - m * ( m + 1 ) / 2.0L;
+    long double const center = m * n / 2.0L;
+
+    if ( !any_ties && m + n <= exact_limit )
+    {
+        std::vector< long double > const ways = u_distribution ( m, n );
+        long double const total =
+                std::accumulate ( ways.begin ( ), ways.end ( ), 0.0L );
+        // as or further from the center than u, on either side.
+        long double const distance = std::fabs ( u - center );
+        long double       tail     = 0;
+        for ( std::size_t v = 0; v < ways.size ( ); v++ )
+        {
+            if ( std::fabs ( v - center ) >= distance - 1e-9L )
+            {
+                tail += ways [ v ];
+            }
+        }
+        return { u, std::min ( 1.0L, tail / total ) };
+    }
+
+    long double const size = m + n;
+    long double const sigma =
+            std::sqrt ( m * n / 12.0L
+                        * ( size + 1 - tie_term / ( size * ( size - 1 ) ) ) );
+    if ( sigma <= 0 )
+    {
+        return { u, 1 };
+    }
+    long double const z =
+            std::max ( 0.0L, std::fabs ( u - center ) - 0.5L ) / sigma;
+    return { u, std::erfc ( z / std::sqrt ( 2.0L ) ) };
+}
+
+long double stats::hedges_g ( samples const &a, samples const &b )
+{
+    if ( a.size ( ) < 2 || b.size ( ) < 2 )
+    {
+        return std::nanl ( "" );
+    }
+    long double const freedom = a.size ( ) + b.size ( ) - 2;
+    long double const pooled  = std::sqrt (
+            ( ( a.size ( ) - 1 ) * variance ( a )
+              + ( b.size ( ) - 1 ) * variance ( b ) )
+            / freedom );
+    long double const difference = mean ( b ) - mean ( a );
+    if ( pooled <= 0 )
+    {
+        return infinitely ( difference );
+    }
+    // the small-sample correction, J, to first order.
+    long double const correction = 1 - 3 / ( 4 * freedom - 1 );
+    return correction * difference / pooled;
+}
+
+void stats::sum_of_means::add ( samples const &x )
+{
+    total += mean ( x );
+    if ( x.size ( ) < 2 )
+    {
+        return;
+    }
+    long double const v = variance ( x ) / x.size ( );
+    total_variance += v;
+    welch_denominator += v * v / ( x.size ( ) - 1 );
+}
+
+long double stats::sum_of_means::half_width ( long double level ) const
+{
+    if ( welch_denominator <= 0 )
+    {
+        return total_variance > 0
+                     ? std::numeric_limits< long double >::infinity ( )
+                     : 0;
+    }
+    long double const degrees_of_freedom =
+            total_variance * total_variance / welch_denominator;
+    return student_t_quantile ( ( 1 + level ) / 2, degrees_of_freedom )
+         * std::sqrt ( total_variance );
+}
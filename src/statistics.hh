@@ -0,0 +1,131 @@
+/**
+ * @file statistics.hh
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief The bits of statistics that the benchmark needs to say how much it
+ * trusts its own numbers.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace markbench::statistics
+{
+    using samples = std::vector< long double >;
+
+    long double mean ( samples const &x );
+
+    /**
+     * @brief Sample (n - 1) variance. Zero with fewer than two samples.
+     */
+    long double variance ( samples const &x );
+
+    long double standard_deviation ( samples const &x );
+
+    long double median ( samples x );
+
+    /**
+     * @brief Marks the samples that lie more than three scaled median absolute
+     * deviations away from the median. The median absolute deviation is used
+     * instead of the standard deviation since a single wild trial inflates the
+     * standard deviation enough to hide itself. Nothing is thrown out with
+     * fewer than five samples.
+     * @return true for every sample that should be thrown out.
+     */
+    std::vector< bool > outliers ( samples const &x );
+
+    /**
+     * @brief Everything we report about a set of trials.
+     */
+    struct summary
+    {
+        std::size_t count              = 0;
+        // the trials thrown out as outliers before summarizing.
+        std::size_t rejected           = 0;
+        long double mean               = 0;
+        long double median             = 0;
+        long double standard_deviation = 0;
+        long double minimum            = 0;
+        long double maximum            = 0;
+        // the 95% confidence interval on the mean.
+        long double confidence_low     = 0;
+        long double confidence_high    = 0;
+    };
+
+    summary summarize ( samples const &x );
+
+    /**
+     * @brief Cumulative distribution function of Student's t distribution.
+     * @param degrees_of_freedom need not be an integer (Welch's test).
+     */
+    long double student_t_cdf ( long double t, long double degrees_of_freedom );
+
+    /**
+     * @brief Inverse of student_t_cdf, found by bisection.
+     */
+    long double student_t_quantile ( long double p,
+                                     long double degrees_of_freedom );
+
+    /**
+     * @brief Half the width of the two-sided confidence interval on the mean.
+     * @param level the confidence level, e.g., 0.95.
+     */
+    long double confidence_half_width ( samples const &x,
+                                        long double    level = 0.95L );
+
+    /**
+     * @brief The outcome of a two-sample test. p_value is two-sided and NaN
+     * when there are too few samples for the test.
+     */
+    struct test_outcome
+    {
+        long double statistic = 0;
+        long double p_value   = 0;
+    };
+
+    /**
+     * @brief Welch's t test for a difference in means. Does not assume equal
+     * variances. Needs at least two samples on each side.
+     */
+    test_outcome welch_t_test ( samples const &a, samples const &b );
+
+    /**
+     * @brief The Mann-Whitney U test, i.e., whether a sample from one side
+     * tends to be larger than a sample from the other. The statistic is U for
+     * a. Exact for small samples without ties, the normal approximation (with
+     * tie and continuity corrections) otherwise.
+     */
+    test_outcome mann_whitney_u_test ( samples const &a, samples const &b );
+
+    /**
+     * @brief Hedges' g: the difference in means (b minus a) over the pooled
+     * standard deviation, corrected for the bias of small samples.
+     */
+    long double hedges_g ( samples const &a, samples const &b );
+
+    /**
+     * @brief A sum of independent means (say, a score added up over tests),
+     * with the confidence interval put together by Welch-Satterthwaite.
+     */
+    class sum_of_means
+    {
+        long double total             = 0;
+        long double total_variance    = 0;
+        long double welch_denominator = 0;
+    public:
+        /**
+         * @brief Adds the mean of the given samples to the sum.
+         */
+        void add ( samples const &x );
+
+        long double value ( ) const noexcept { return total; }
+
+        long double half_width ( long double level = 0.95L ) const;
+    };
+} // namespace markbench::statistics
@@ -0,0 +1,251 @@
+/**
+ * @file stream.cc
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief The bandwidth kernels and the per-thread arrays they go through.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+
+#include "stream.hh"
+#include "host.hh"
+#include "test-utils.hh"
+
+#if defined( __x86_64__ )
+#    include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <new>
+#include <string>
+
+namespace host   = markbench::host;
+namespace stream = markbench::stream;
+
+namespace
+{
+    // two doubles, which every x86-64 processor can load and store at once.
+    typedef double pair __attribute__ ( ( vector_size ( 16 ), __may_alias__ ) );
+
+    constexpr std::size_t lanes  = sizeof ( pair ) / sizeof ( double );
+    constexpr double      scalar = 3;
+    // how big each array is at least, for when the cache size is unknown.
+    constexpr std::size_t smallest_array = std::size_t ( 64 ) << 20;
+
+    enum class kernel
+    {
+        // b = a
+        copy,
+        // b = scalar * a
+        scale,
+        // c = a + b
+        add,
+        // c = a + scalar * b
+        triad,
+        // the sum of a
+        read,
+        // a = scalar
+        write,
+    };
+
+    std::string kernel_name ( kernel const k )
+    {
+        switch ( k )
+        {
+            case kernel::copy: return "copy";
+            case kernel::scale: return "scale";
+            case kernel::add: return "add";
+            case kernel::triad: return "triad";
+            case kernel::read: return "read";
+            case kernel::write: return "write";
+            default: return "?";
+        }
+    }
+
+    /**
+     * @brief How many arrays a kernel goes through, which is also how many
+     * doubles it moves per element. As in STREAM, the cache line that an
+     * ordinary store has to read first is not counted.
+     */
+    constexpr unsigned arrays ( kernel const k )
+    {
+        switch ( k )
+        {
+            case kernel::add:
+            case kernel::triad: return 3;
+            case kernel::copy:
+            case kernel::scale: return 2;
+            default: return 1;
+        }
+    }
+
+    // four times the last level cache, as STREAM asks for.
+    std::size_t array_bytes ( )
+    {
+        return std::max ( 4 * host::last_level_cache ( ), smallest_array );
+    }
+
+    inline pair load ( double const *from )
+    {
+        return *reinterpret_cast< pair const * > ( from );
+    }
+
+    template < bool nontemporal > inline void store ( double *to, pair value )
+    {
+#if defined( __x86_64__ )
+        if constexpr ( nontemporal )
+        {
+            _mm_stream_pd ( to, value );
+            return;
+        }
+#endif
+        *reinterpret_cast< pair * > ( to ) = value;
+    }
+
+    struct aligned_delete
+    {
+        void operator( ) ( double *p ) const
+        {
+            ::operator delete ( p, std::align_val_t { 64 } );
+        }
+    };
+
+    using array = std::unique_ptr< double [], aligned_delete >;
+
+    /**
+     * @brief The per-thread fixture of a bandwidth test. The thread fills its
+     * slice of the arrays when it builds the fixture, before the test starts,
+     * so the first touch of every page is from the CPU that the thread is
+     * pinned to. Each iteration then goes through the next per_iteration
+     * elements, wrapping around at the end of the slice.
+     */
+    template < kernel k, bool nontemporal > class bandwidth
+    {
+        std::size_t            length;
+        std::size_t            offset = 0;
+        std::array< array, 3 > x;
+    public:
+        explicit bandwidth ( markbench::fixture_context const &context )
+        {
+            length = array_bytes ( ) / sizeof ( double ) / context.threads
+                   / stream::per_iteration * stream::per_iteration;
+            length = std::max ( length, stream::per_iteration );
+            // STREAM's starting values.
+            double const initial [] = { 1, 2, 0 };
+            for ( unsigned i = 0; i < arrays ( k ); i++ )
+            {
+                x [ i ].reset ( static_cast< double * > ( ::operator new (
+                        length * sizeof ( double ),
+                        std::align_val_t { 64 } ) ) );
+                std::fill_n ( x [ i ].get ( ), length, initial [ i ] );
+            }
+        }
+
+        void operator( ) ( )
+        {
+            auto const at = [ & ] ( unsigned const i ) {
+                return x [ i ].get ( ) + offset;
+            };
+            if constexpr ( k == kernel::read )
+            {
+                // four sums, so that the adds keep up with the loads.
+                double const *a          = at ( 0 );
+                pair          sums [ 4 ] = { };
+                for ( std::size_t i = 0; i < stream::per_iteration;
+                      i += 4 * lanes )
+                {
+                    sums [ 0 ] += load ( a + i );
+                    sums [ 1 ] += load ( a + i + lanes );
+                    sums [ 2 ] += load ( a + i + 2 * lanes );
+                    sums [ 3 ] += load ( a + i + 3 * lanes );
+                }
+                pair const sum = sums [ 0 ] + sums [ 1 ] + sums [ 2 ]
+                               + sums [ 3 ];
+                keep_result ( sum [ 0 ] + sum [ 1 ] );
+            } else
+            {
+                for ( std::size_t i = 0; i < stream::per_iteration;
+                      i += lanes )
+                {
+                    if constexpr ( k == kernel::copy )
+                    {
+                        pair const a = load ( at ( 0 ) + i );
+                        store< nontemporal > ( at ( 1 ) + i, a );
+                    } else if constexpr ( k == kernel::scale )
+                    {
+                        pair const a = load ( at ( 0 ) + i );
+                        store< nontemporal > ( at ( 1 ) + i, scalar * a );
+                    } else if constexpr ( k == kernel::add )
+                    {
+                        pair const a = load ( at ( 0 ) + i );
+                        pair const b = load ( at ( 1 ) + i );
+                        store< nontemporal > ( at ( 2 ) + i, a + b );
+                    } else if constexpr ( k == kernel::triad )
+                    {
+                        pair const a = load ( at ( 0 ) + i );
+                        pair const b = load ( at ( 1 ) + i );
+                        store< nontemporal > ( at ( 2 ) + i, a + scalar * b );
+                    } else
+                    {
+                        store< nontemporal > ( at ( 0 ) + i,
+                                               pair { scalar, scalar } );
+                    }
+                }
+#if defined( __x86_64__ )
+                // the non-temporal stores are weakly ordered, so they are
+                // all out of the write-combining buffers before the next
+                // iteration is counted.
+                if constexpr ( nontemporal )
+                {
+                    _mm_sfence ( );
+                }
+#endif
+            }
+            offset = ( offset + stream::per_iteration ) % length;
+        }
+    };
+
+    template < kernel k, bool nontemporal >
+    individual_test bandwidth_test ( )
+    {
+        std::string const id = "test.stream." + kernel_name ( k )
+                             + ( nontemporal ? ".nontemporal" : "" );
+        individual_test result =
+                fixture_test< bandwidth< k, nontemporal > > ( id );
+        result.unavailable = [] ( ) -> std::string const & {
+            static std::string reason;
+            reason = host::memory_shortfall ( arrays ( k ) * array_bytes ( ) );
+#if !defined( __x86_64__ )
+            if ( nontemporal )
+            {
+                reason = "non-temporal stores are only built for x86-64";
+            }
+#endif
+            return reason;
+        };
+        result.bytes = arrays ( k ) * stream::per_iteration * sizeof ( double );
+        return result;
+    }
+} // namespace
+
+test_suite stream::suite ( )
+{
+    return {
+            bandwidth_test< kernel::copy, false > ( ),
+            bandwidth_test< kernel::scale, false > ( ),
+            bandwidth_test< kernel::add, false > ( ),
+            bandwidth_test< kernel::triad, false > ( ),
+            bandwidth_test< kernel::read, false > ( ),
+            bandwidth_test< kernel::write, false > ( ),
+            bandwidth_test< kernel::copy, true > ( ),
+            bandwidth_test< kernel::scale, true > ( ),
+            bandwidth_test< kernel::add, true > ( ),
+            bandwidth_test< kernel::triad, true > ( ),
+            bandwidth_test< kernel::write, true > ( ),
+    };
+}
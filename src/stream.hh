@@ -0,0 +1,36 @@
+/**
+ * @file stream.hh
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Sustained memory bandwidth, after McCalpin's STREAM: Copy, Scale,
+ * Add and Triad, plus a kernel that only reads and one that only writes, over
+ * arrays several times the size of the last level cache.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+#pragma once
+
+#include "test-suite.hh"
+
+#include <cstddef>
+
+namespace markbench::stream
+{
+    /**
+     * @brief How many elements of each array one iteration goes through. An
+     * iteration is a fixed amount of work, whatever the thread count, so the
+     * rhedstones of a bandwidth test scale with its bandwidth.
+     */
+    inline constexpr std::size_t per_iteration = 4096;
+
+    /**
+     * @brief Every kernel, with ordinary stores and, for the kernels that
+     * store, with non-temporal stores that go around the caches. Each thread
+     * owns its own slice of the arrays and touches it first, so that the
+     * operating system places it on the thread's own memory node.
+     */
+    test_suite suite ( );
+} // namespace markbench::stream
@@ -12,11 +12,19 @@
 
 #include "test-runner.hh"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <functional>
 #include <iostream>
+#include <thread>
+#include <tuple>
 #include <vector>
 
+#include "instructions.hh"
+#include "isa-dispatch.hh"
+#include "isolation.hh"
+#include "memory-latency.hh"
 #include "messages.hh"
 #include "test-suite.hh"
 #include "test-utils.hh"
@@ -25,35 +33,410 @@ void test_runner::run_test ( )
 {
     // now, if the test becomes significantly long, we want to account for the
     // system heating up. So, we will shuffle around the test.
+    *log << generator->timer_message ( markbench::timing::calibrated ( ) );
+    *log << generator->isa_message (
+            markbench::isa::level_name ( markbench::isa::selected ( ) ) );
     std::shuffle ( suite.begin ( ), suite.end ( ), randomness );
+    *log << generator->shuffle_message ( seed );
 
     for ( auto x : suite ) { run_tests ( x ); }
 
-    std::cout << generator->list_rhedstone_count ( one_thread_total,
-                                                   all_thread_total );
+    list_scaling ( );
+    list_ladder ( );
+    *log << generator->list_rhedstone_count (
+            one_thread_total,
+            all_thread_total,
+            one_thread_error.half_width ( ),
+            all_thread_error.half_width ( ) );
+}
+
+std::vector< markbench::thread_count > test_runner::sweep_thread_counts ( )
+{
+    std::vector< markbench::thread_count > result;
+    for ( markbench::thread_count i = 1; i < all_thread; i *= 2 )
+    {
+        result.push_back ( i );
+    }
+    result.push_back ( std::max ( all_thread, one_thread ) );
+    result.push_back ( markbench::topology::physical_cores ( ) );
+    std::sort ( result.begin ( ), result.end ( ) );
+    result.erase ( std::unique ( result.begin ( ), result.end ( ) ),
+                   result.end ( ) );
+    return result;
 }
 
 void test_runner::run_tests ( individual_test t )
 {
-    run_test_pass ( false, t );
-    run_test_pass ( true, t );
+    if ( t.unavailable && !t.unavailable ( ).empty ( ) )
+    {
+        skips.push_back ( { t.name_id, t.unavailable ( ) } );
+        *log << generator->skip_message ( skips.back ( ).id,
+                                          skips.back ( ).reason );
+        return;
+    }
+    loop_overhead = ( t.loops.measured ? markbench::test ( t.loops )
+                                       : markbench::test ( t.function ) )
+                            .loop_overhead ( );
+    for ( std::size_t i = 0; i < thread_counts.size ( ); i++ )
+    {
+        run_test_pass ( i, t );
+    }
 }
 
-void test_runner::run_test_pass ( bool count, individual_test t )
+pass_record test_runner::measure_pass ( individual_test const        &t,
+                                       markbench::thread_count const threads )
 {
-    auto [ id, fn ]             = t;
-    auto                    now = current_time ( );
-    auto                    end = current_time ( );
-    accumulated_score      *as  = count ? &all_thread_total : &one_thread_total;
-    markbench::thread_count threads = count ? all_thread : one_thread;
-    markbench::test        *runner  = new markbench::test ( fn );
+    auto const                    &id     = t.name_id;
+    markbench::test               *runner =
+            t.loops.measured ? new markbench::test ( t.loops )
+                                           : new markbench::test ( t.function );
+    pass_record                    record { .id        = id,
+                                            .threads   = threads,
+                                            .placement = placement };
+    markbench::run_options const   options {
+            length,
+            markbench::topology::place ( placement, threads ),
+            performance_counters,
+            latency,
+    };
+    markbench::statistics::samples samples;
+    markbench::statistics::samples kept;
 
-    std::cout << generator->test_message ( id, threads );
-    now          = current_time ( );
-    auto results = runner->run ( threads );
-    end          = current_time ( );
-    accumulate ( *as, results, end - now );
-    std::cout << generator->list_results ( results );
+    *log << generator->test_message ( id, threads );
+    if ( warmup.count ( ) > 0 )
+    {
+        // just long enough to bring the caches, branch predictors and clocks
+        // up to speed. Nothing about it is kept.
+        markbench::run_length warming;
+        warming.minimum = warmup;
+        warming.maximum = warmup;
+        warming.window  = std::min ( warming.window, warmup );
+        runner->run ( threads, { warming, options.placement } );
+    }
+    markbench::thermal::sampler clocks { options.placement };
+    for ( std::size_t i = 0; i < trials; i++ )
+    {
+        auto results          = runner->run ( threads, options );
+        results.loop_overhead = loop_overhead;
+        *log << generator->list_results ( results );
+        samples.push_back ( throughput ( results ) );
+        record.trials.push_back ( results );
+    }
+    record.clocks = clocks.stop ( );
     delete runner;
-    as = nullptr;
-}
\ No newline at end of file
+
+    // a trial that the OS interrupted should not drag the whole test around.
+    record.rejected = markbench::statistics::outliers ( samples );
+    for ( std::size_t i = 0; i < samples.size ( ); i++ )
+    {
+        if ( !record.rejected [ i ] )
+        {
+            kept.push_back ( samples [ i ] );
+        }
+    }
+    record.summary          = markbench::statistics::summarize ( kept );
+    record.summary.rejected = samples.size ( ) - kept.size ( );
+    *log << generator->list_statistics ( record.summary );
+    *log << generator->list_clocks ( record.clocks );
+    if ( t.instructions > 0 )
+    {
+        count_instructions ( t, record );
+    }
+    if ( t.loads > 0 )
+    {
+        long double const per_iteration = threads / record.summary.mean;
+        record.nanoseconds_per_load =
+                ( per_iteration - loop_overhead ) / t.loads;
+        *log << generator->list_load_latency ( record.nanoseconds_per_load );
+    }
+    if ( t.bytes > 0 )
+    {
+        // iterations per nanosecond, over every thread, times bytes.
+        record.gigabytes_per_second = record.summary.mean * t.bytes;
+        long double const cycles    = cycles_per_iteration ( record );
+        if ( std::isnan ( cycles ) || cycles <= 0 )
+        {
+            record.bytes_per_cycle =
+                    record.gigabytes_per_second / record.threads
+                    / markbench::instructions::estimate_clock ( );
+        } else
+        {
+            record.bytes_per_cycle = t.bytes / cycles;
+        }
+        *log << generator->list_bandwidth ( record.gigabytes_per_second,
+                                            record.bytes_per_cycle );
+    }
+    if ( latency )
+    {
+        for ( std::size_t i = 0; i < samples.size ( ); i++ )
+        {
+            if ( !record.rejected [ i ] )
+            {
+                record.latencies += record.trials [ i ].latencies;
+            }
+        }
+        *log << generator->list_latency ( record.latencies );
+    }
+    return record;
+}
+
+long double test_runner::cycles_per_iteration ( pass_record const &record )
+{
+    long double cycles = 0;
+    std::size_t kept   = 0;
+    for ( std::size_t i = 0; i < record.trials.size ( ); i++ )
+    {
+        if ( !record.rejected [ i ] )
+        {
+            cycles += record.trials [ i ].events.per_iteration (
+                    markbench::perf::cycles );
+            kept++;
+        }
+    }
+    return cycles / kept;
+}
+
+void test_runner::count_instructions ( individual_test const &t,
+                                       pass_record           &record )
+{
+    long double const cycles         = cycles_per_iteration ( record );
+    long double const per_nanosecond = record.summary.mean / record.threads;
+    if ( std::isnan ( cycles ) || cycles <= 0 )
+    {
+        record.core_gigahertz = markbench::instructions::estimate_clock ( );
+        record.instructions_per_cycle =
+                per_nanosecond * t.instructions / record.core_gigahertz;
+    } else
+    {
+        record.core_gigahertz         = per_nanosecond * cycles;
+        record.instructions_per_cycle = t.instructions / cycles;
+    }
+    *log << generator->list_instructions ( record.instructions_per_cycle,
+                                           record.core_gigahertz );
+}
+
+bool test_runner::measure_apart ( individual_test const        &t,
+                                 markbench::thread_count const threads,
+                                 pass_record                  &record )
+{
+    if ( !isolate )
+    {
+        record = measure_pass ( t, threads );
+        return true;
+    }
+    // or the child prints everything still in the buffers again.
+    log->flush ( );
+    std::cout.flush ( );
+    std::clog.flush ( );
+    auto const outcome = markbench::isolation::run_isolated (
+            [ & ] ( ) { return measure_pass ( t, threads ); } );
+    if ( !outcome.failure.empty ( ) )
+    {
+        skips.push_back ( { t.name_id,
+                            outcome.failure + " on "
+                                    + std::to_string ( threads )
+                                    + " threads" } );
+        *log << generator->skip_message ( skips.back ( ).id,
+                                          skips.back ( ).reason );
+        return false;
+    }
+    record = outcome.record;
+    return true;
+}
+
+long double test_runner::usual_clock ( markbench::thread_count const threads )
+{
+    markbench::statistics::samples clocks;
+    for ( auto const &r : records )
+    {
+        if ( r.threads == threads && r.clocks.has_clock ( ) && !r.throttled )
+        {
+            clocks.push_back ( r.clocks.mean_megahertz );
+        }
+    }
+    if ( clocks.empty ( ) )
+    {
+        return std::nanl ( "" );
+    }
+    return markbench::statistics::summarize ( clocks ).median;
+}
+
+void test_runner::run_test_pass ( std::size_t index, individual_test t )
+{
+    // the first one-thread pass and the last all-thread pass make the scores.
+    std::size_t single_index = thread_counts.size ( );
+    std::size_t multi_index  = thread_counts.size ( );
+    for ( std::size_t i = 0; i < thread_counts.size ( ); i++ )
+    {
+        if ( thread_counts [ i ] == one_thread
+             && single_index == thread_counts.size ( ) )
+        {
+            single_index = i;
+        }
+        if ( thread_counts [ i ] == all_thread )
+        {
+            multi_index = i;
+        }
+    }
+    bool const single = index == single_index;
+    bool const multi  = index == multi_index;
+
+    markbench::thread_count const threads = thread_counts [ index ];
+    markbench::thread_count const fewest  = *std::min_element (
+            thread_counts.begin ( ), thread_counts.end ( ) );
+    long double const             usual   = usual_clock ( threads );
+    // a pass on more threads is also held to the passes on the fewest, which
+    // is where the throttling of a hot, busy machine shows. It only counts
+    // below the base clock, since above it a lower clock is only the turbo
+    // the CPUs allow with more of them busy.
+    long double const baseline =
+            threads > fewest ? usual_clock ( fewest ) : std::nanl ( "" );
+    long double const base = markbench::thermal::base_megahertz ( );
+    pass_record       record;
+    if ( !measure_apart ( t, threads, record ) )
+    {
+        return;
+    }
+
+    auto const below = [ & ] ( pass_record const &r, long double const clock ) {
+        return r.clocks.has_clock ( ) && !std::isnan ( clock )
+            && r.clocks.mean_megahertz < clock * ( 1 - throttle_limit );
+    };
+    auto const throttled = [ & ] ( pass_record const &r ) {
+        return below ( r, usual )
+            || ( below ( r, baseline ) && r.clocks.mean_megahertz < base );
+    };
+    if ( throttled ( record ) )
+    {
+        bool const same = below ( record, usual );
+        *log << generator->throttle_message ( record.clocks.mean_megahertz,
+                                              same ? usual : baseline,
+                                              same ? threads : fewest,
+                                              rerun_throttled );
+        if ( rerun_throttled )
+        {
+            std::this_thread::sleep_for ( cooldown );
+            if ( !measure_apart ( t, threads, record ) )
+            {
+                return;
+            }
+            record.rerun = true;
+        }
+        record.throttled = throttled ( record );
+    }
+
+    markbench::statistics::samples kept;
+    for ( std::size_t i = 0; i < record.trials.size ( ); i++ )
+    {
+        if ( !record.rejected [ i ] )
+        {
+            kept.push_back ( throughput ( record.trials [ i ] ) );
+        }
+    }
+    auto score = [ & ] ( accumulated_score                   &as,
+                         markbench::statistics::sum_of_means &error ) {
+        for ( std::size_t i = 0; i < record.trials.size ( ); i++ )
+        {
+            if ( !record.rejected [ i ] )
+            {
+                accumulate ( as, record.trials [ i ], 1.0L / kept.size ( ) );
+            }
+        }
+        error.add ( kept );
+    };
+    if ( single )
+    {
+        score ( one_thread_total, one_thread_error );
+    }
+    if ( multi )
+    {
+        score ( all_thread_total, all_thread_error );
+    }
+    records.push_back ( record );
+}
+
+void test_runner::list_ladder ( )
+{
+    namespace memory_latency = markbench::memory_latency;
+    std::vector< memory_latency::rung > rungs;
+    for ( auto const &r : records )
+    {
+        if ( !std::isnan ( r.nanoseconds_per_load ) )
+        {
+            rungs.push_back ( { r.id, r.threads, r.nanoseconds_per_load } );
+        }
+    }
+    if ( rungs.empty ( ) )
+    {
+        return;
+    }
+    // by page size, then thread count, then working set.
+    auto const key = [] ( memory_latency::rung const &r ) {
+        auto const size = memory_latency::parse_id ( r.id );
+        return std::make_tuple ( size && size->huge_pages,
+                                 r.threads,
+                                 size ? size->bytes : 0 );
+    };
+    std::sort ( rungs.begin ( ), rungs.end ( ), [ & ] ( auto a, auto b ) {
+        return key ( a ) < key ( b );
+    } );
+    *log << generator->list_ladder ( rungs );
+}
+
+void test_runner::list_scaling ( )
+{
+    for ( auto const &t : suite )
+    {
+        pass_record const *base = nullptr;
+        for ( auto const &r : records )
+        {
+            if ( r.id == t.name_id && r.threads == one_thread )
+            {
+                base = &r;
+                break;
+            }
+        }
+        if ( !base || base->summary.mean <= 0 )
+        {
+            continue;
+        }
+
+        std::vector< markbench::scaling_point > points;
+        for ( auto const &r : records )
+        {
+            if ( r.id != t.name_id )
+            {
+                continue;
+            }
+            long double const speedup = r.summary.mean / base->summary.mean;
+            points.push_back ( { r.threads,
+                                 r.summary.mean,
+                                 speedup,
+                                 speedup / r.threads } );
+        }
+        std::sort ( points.begin ( ), points.end ( ), [] ( auto a, auto b ) {
+            return a.threads < b.threads;
+        } );
+
+        // the knee is the last point reached while every added thread still
+        // brought at least half of a thread's worth of throughput with it.
+        std::size_t knee = 0;
+        for ( std::size_t i = 1; i < points.size ( ); i++ )
+        {
+            long double const added =
+                    points [ i ].threads - points [ i - 1 ].threads;
+            if ( added == 0 )
+            {
+                continue;
+            }
+            long double const gained =
+                    points [ i ].speedup - points [ i - 1 ].speedup;
+            if ( gained / added < 0.5L )
+            {
+                break;
+            }
+            knee = i;
+        }
+        *log << generator->list_scaling ( t.name_id, points, knee );
+    }
+}
@@ -13,20 +13,113 @@
 #pragma once
 
 #include <chrono>
+#include <cmath>
 #include <iostream>
+#include <optional>
+#include <random>
+#include <string>
 #include <vector>
 
 #include "messages.hh"
+#include "statistics.hh"
 #include "test-suite.hh"
 #include "test-utils.hh"
+#include "thermal.hh"
+#include "topology.hh"
 
 inline markbench::thread_count hardware_threads ( )
 {
     return std::thread::hardware_concurrency ( );
 }
 
+/**
+ * @brief How the runner runs each test.
+ */
+struct runner_options
+{
+    markbench::run_length                  length;
+    std::size_t                            trials = 5;
+    // the thread counts to run every test at, in order. Empty means one thread
+    // and then all threads.
+    std::vector< markbench::thread_count > thread_counts;
+    markbench::topology::placement_policy  placement =
+            markbench::topology::placement_policy::none;
+    bool                                   performance_counters = false;
+    // time every iteration and report the latency percentiles of each pass.
+    bool                                   latency              = false;
+    // how long to run each test, unmeasured, before its first trial at each
+    // thread count. Zero means no warmup.
+    markbench::test_duration               warmup =
+            std::chrono::milliseconds ( 500 );
+    // a pass is throttled if its CPUs averaged this much (relatively) below
+    // the median clock of the other passes at its thread count, or, below the
+    // base clock, of the passes on the fewest threads.
+    long double                            throttle_limit  = 0.05L;
+    // whether to cool down and measure a throttled pass again.
+    bool                                   rerun_throttled = false;
+    // whether to run every pass in a new process, so that no test inherits
+    // another's heap, caches, or static state, and a crash only loses that
+    // pass. Only where isolation::supported.
+    bool                                   isolate         = false;
+    // shuffles the tests in the same order every time. A random seed if
+    // empty.
+    std::optional< rng::result_type >      seed;
+    // where the human-readable results go.
+    std::ostream                          *log = &std::cout;
+};
+
 using accumulated_score = std::vector< long double >;
 
+/**
+ * @brief Everything measured for one test at one thread count.
+ */
+struct pass_record
+{
+    std::string                           id;
+    markbench::thread_count               threads;
+    markbench::topology::placement_policy placement;
+    std::vector< markbench::test_result > trials { };
+    // which trials were thrown out as outliers.
+    std::vector< bool >                   rejected { };
+    markbench::statistics::summary        summary { };
+    // every kept trial's latencies, merged.
+    markbench::latency::distribution      latencies { };
+    // the clocks and temperatures over the trials.
+    markbench::thermal::summary           clocks { };
+    // whether the CPUs ran too slowly, and whether this is the second try.
+    bool                                  throttled = false;
+    bool                                  rerun     = false;
+    // for tests of single instructions: how many the core retired per cycle
+    // on each thread, and the clock that was taken as. The clock is from the
+    // cycle counter if it could be read, which makes an AVX license show as
+    // a lower clock. Otherwise it is instructions::estimate_clock, the clock
+    // scalar code gets, which makes it show as fewer instructions per cycle.
+    // Both NaN for every other test.
+    long double                           instructions_per_cycle =
+            std::nanl ( "" );
+    long double                           core_gigahertz = std::nanl ( "" );
+    // for the memory latency ladder: how long each load took, less the
+    // harness's share. NaN for every other test.
+    long double                           nanoseconds_per_load =
+            std::nanl ( "" );
+    // for the tests measured in bytes per second: the bytes all the threads
+    // moved or made together, in GB/s. NaN for every other test.
+    long double                           gigabytes_per_second =
+            std::nanl ( "" );
+    // and what each thread moved or made per cycle of its core. The clock is
+    // taken as for instructions_per_cycle.
+    long double                           bytes_per_cycle = std::nanl ( "" );
+};
+
+/**
+ * @brief A test that could not run on this machine, and why.
+ */
+struct skipped_test
+{
+    std::string id;
+    std::string reason;
+};
+
 class test_runner
 {
     using duration = std::chrono::steady_clock::duration;
@@ -34,20 +127,55 @@ class test_runner
     test_suite                                  suite;
     accumulated_score                           one_thread_total;
     accumulated_score                           all_thread_total;
+    markbench::statistics::sum_of_means         one_thread_error;
+    markbench::statistics::sum_of_means         all_thread_error;
+    std::vector< pass_record >                  records;
+    std::vector< skipped_test >                 skips;
     rng                                         randomness;
+    markbench::run_length                       length;
+    std::size_t                                 trials;
+    std::vector< markbench::thread_count >      thread_counts;
+    markbench::topology::placement_policy       placement;
+    bool                                        performance_counters;
+    bool                                        latency;
+    markbench::test_duration                    warmup;
+    long double                                 throttle_limit;
+    bool                                        rerun_throttled;
+    bool                                        isolate;
+    rng::result_type                            seed;
+    std::ostream                               *log;
+    // nanoseconds per iteration of the empty loop of the test being run.
+    long double                                 loop_overhead = 0;
+    // how long a throttled machine gets to cool off before the rerun.
+    inline static markbench::test_duration const cooldown =
+            std::chrono::seconds ( 10 );
     inline static markbench::thread_count const one_thread = 1;
     inline static markbench::thread_count const all_thread =
             hardware_threads ( );
 
-    static inline void accumulate ( accumulated_score              &a,
-                                    markbench::test_counters const &c,
-                                    duration const                 &d )
+    /**
+     * @brief Rhedstones, i.e., iterations per nanosecond over all threads.
+     */
+    static inline long double throughput ( markbench::test_result const &r )
     {
+        long double total = 0;
+        for ( auto const &c : r.counters ) { total += c; }
+        return total / r.elapsed.count ( );
+    }
+
+    // weight is one over the number of trials averaged into the score.
+    static inline void accumulate ( accumulated_score             &a,
+                                    markbench::test_result const &r,
+                                    long double const             weight )
+    {
+        auto const &c           = r.counters;
+        auto const &d           = r.elapsed;
         long double grand_total = 0;
         for ( std::size_t i = 0; i < c.size ( ); i++ )
         {
             long double value = c.at ( i );
             value /= d.count ( );
+            value *= weight;
             grand_total += value;
             a.at ( i ) += value;
         }
@@ -66,19 +194,73 @@ class test_runner
         return std::chrono::steady_clock::now ( );
     }
 
-    // if count -> all threads.
-    void run_test_pass ( bool count, individual_test t );
+    // the pass at index counts towards the single- or multi-threaded score if
+    // it is the first one-thread pass or the last all-thread pass.
+    void run_test_pass ( std::size_t index, individual_test t );
+
+    // warms up, runs the trials, and summarizes them, but does not score.
+    pass_record measure_pass ( individual_test const        &t,
+                               markbench::thread_count const threads );
+
+    // the instructions per cycle of a pass of a test of single instructions.
+    void count_instructions ( individual_test const &t, pass_record &record );
+
+    /**
+     * @brief The cycles one iteration took on each thread, averaged over the
+     * kept trials, or NaN if not every one of them could count cycles.
+     */
+    long double cycles_per_iteration ( pass_record const &record );
+
+    // measure_pass, in a process of its own if isolated. False if that
+    // process died, in which case the pass is skipped.
+    bool measure_apart ( individual_test const        &t,
+                         markbench::thread_count const threads,
+                         pass_record                  &record );
+
+    // the median clock of the passes so far at the given thread count that
+    // were not throttled. NaN if there are none.
+    long double usual_clock ( markbench::thread_count const threads );
 
     void run_tests ( individual_test t );
+
+    void list_scaling ( );
+
+    // the memory latency ladder, from the smallest working set up.
+    void list_ladder ( );
 public:
-    test_runner ( message_generator *const &g, test_suite const &s )
+    test_runner ( message_generator *const &g,
+                  test_suite const        &s,
+                  runner_options const    &o = runner_options { } )
     {
-        generator = g;
-        suite     = s;
+        generator            = g;
+        suite                = s;
+        length               = o.length;
+        trials               = o.trials;
+        thread_counts        = o.thread_counts;
+        placement            = o.placement;
+        performance_counters = o.performance_counters;
+        latency              = o.latency;
+        warmup               = o.warmup;
+        throttle_limit       = o.throttle_limit;
+        rerun_throttled      = o.rerun_throttled;
+        isolate              = o.isolate;
+        seed                 = o.seed ? *o.seed : std::random_device { }( );
+        randomness           = rng ( seed );
+        log                  = o.log;
+        if ( thread_counts.empty ( ) )
+        {
+            thread_counts = { one_thread, all_thread };
+        }
         fill_score_accumulator ( one_thread_total, one_thread );
         fill_score_accumulator ( all_thread_total, all_thread );
     }
 
+    /**
+     * @brief 1, 2, 4, ... up to all threads, plus all threads and the number
+     * of physical cores, in increasing order.
+     */
+    static std::vector< markbench::thread_count > sweep_thread_counts ( );
+
     ~test_runner ( )
     {
         delete generator;
@@ -86,4 +268,25 @@ public:
     }
 
     void run_test ( );
+
+    std::vector< pass_record > const &passes ( ) const { return records; }
+
+    // the tests that are in no pass, and so in neither score.
+    std::vector< skipped_test > const &skipped ( ) const { return skips; }
+
+    // the scores that run_test prints at the end, with the half-widths of
+    // their 95% confidence intervals.
+    long double single_score ( ) const { return one_thread_total.front ( ); }
+
+    long double multi_score ( ) const { return all_thread_total.back ( ); }
+
+    long double single_error ( ) const
+    {
+        return one_thread_error.half_width ( );
+    }
+
+    long double multi_error ( ) const
+    {
+        return all_thread_error.half_width ( );
+    }
 };
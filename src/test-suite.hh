@@ -13,17 +13,65 @@
 
 #include "test.hh"
 
+#include <functional>
 #include <string>
 #include <vector>
 
 struct individual_test
 {
     std::string              name_id;
+    // the kernel of a test without loops of its own, called through the
+    // std::function every iteration (see markbench::function_loops). Empty
+    // for the tests that have loops.
     markbench::test_function function;
+    // if set, measured instead of function. See batched_test and
+    // fixture_test.
+    markbench::test_loops    loops { };
+    // why the test cannot run on this machine, or empty if it can. Only asked
+    // right before the test would run. Always runnable if unset.
+    std::function< std::string const &( ) > unavailable { };
+    // how many instructions under test one iteration executes, for tests of
+    // single instructions (see instructions.hh). 0 for everything else.
+    std::size_t                             instructions = 0;
+    // how many dependent loads one iteration makes, for the memory latency
+    // ladder (see memory-latency.hh). 0 for everything else.
+    std::size_t                             loads        = 0;
+    // how many bytes one iteration moves or makes, for the tests measured in
+    // bytes per second (see stream.hh and entropy.hh). 0 for everything else.
+    std::size_t                             bytes        = 0;
 };
 
+/**
+ * @brief A test whose measurement loop is compiled around the kernel itself,
+ * for kernels so cheap that a std::function call per iteration would swamp
+ * them. The kernel runs batch times per counter update.
+ */
+template < auto kernel, std::size_t batch = 16 >
+individual_test batched_test ( std::string const &name_id )
+{
+    return { name_id, { }, markbench::batched_loops< kernel, batch > ( ) };
+}
+
+/**
+ * @brief A test made from a fixture (see markbench::fixture_loops), so that
+ * its setup, reset and teardown stay out of the measured time. Each thread's
+ * fixture is constructed from arguments.
+ */
+template < typename fixture_type,
+           std::size_t batch = 1,
+           typename... argument_types >
+individual_test fixture_test ( std::string const    &name_id,
+                               argument_types const &...arguments )
+{
+    return { name_id,
+             { },
+             markbench::fixture_loops< fixture_type, batch > ( arguments... ) };
+}
+
 using test_suite = std::vector< individual_test >;
 
 test_suite version_now ( );
+// the version that version_now runs, e.g., "001".
+std::string version_now_name ( );
 test_suite version_000 ( );
 test_suite version_001 ( );
\ No newline at end of file
@@ -11,21 +11,63 @@
  */
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <random>
+#include <tuple>
 
 /**
  * @brief Version of std::default_random_engine that automatically gives itself
- * a seed using std::random_device
+ * a seed using std::random_device, unless given one to repeat a sequence.
  *
  */
 class rng
 {
-    std::random_device         device;
-    std::default_random_engine engine { device ( ) };
+    using engine_type = std::default_random_engine;
+    engine_type engine;
 public:
-    using result_type = typename std::default_random_engine::result_type;
+    using result_type = typename engine_type::result_type;
 
-    result_type min ( ) { return engine.min ( ); }
-    result_type max ( ) { return engine.max ( ); }
-    auto        operator( ) ( ) noexcept { return engine ( ); }
-};
\ No newline at end of file
+    rng ( ) : engine { std::random_device { }( ) } { }
+
+    explicit rng ( result_type const seed ) : engine { seed } { }
+
+    // std::uniform_random_bit_generator needs these to be constant
+    // expressions.
+    static constexpr result_type min ( ) { return engine_type::min ( ); }
+    static constexpr result_type max ( ) { return engine_type::max ( ); }
+    auto operator( ) ( ) noexcept { return engine ( ); }
+};
+
+/**
+ * @brief Makes the compiler believe that the value is used, so that a kernel
+ * whose result nobody reads is not optimized away.
+ */
+template < typename T > inline void keep_result ( T const &value )
+{
+    asm volatile ( "" : : "g" ( value ) : "memory" );
+}
+
+/**
+ * @brief The T made from the arguments that every thread of a pass shares.
+ * The first thread to ask makes it, during setup, the others get the same one,
+ * and it is freed once the last of them is done with it. A pass that asks with
+ * other arguments, or after the last pass's T is freed, gets a new one.
+ */
+template < typename T, typename... Arguments >
+std::shared_ptr< T > shared_per_pass ( Arguments const &...arguments )
+{
+    static std::mutex                 building;
+    static std::weak_ptr< T >         last;
+    static std::tuple< Arguments... > last_arguments;
+
+    std::scoped_lock lock { building };
+    auto             result = last.lock ( );
+    if ( !result || last_arguments != std::tie ( arguments... ) )
+    {
+        result         = std::make_shared< T > ( arguments... );
+        last           = result;
+        last_arguments = std::tie ( arguments... );
+    }
+    return result;
+}
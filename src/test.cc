@@ -11,11 +11,17 @@
  */
 #include "test.hh"
 
+#include "counters.hh"
+#include "statistics.hh"
+#include "topology.hh"
+
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <iostream>
+#include <limits>
 #include <memory>
-using counter_type = std::unique_ptr< std::atomic_uintmax_t >;
+#include <numeric>
 
 class test_latch
 {
@@ -35,63 +41,240 @@ public:
     void arrive ( ) { latch.fetch_sub ( 1 ); }
 };
 
-markbench::test_counters markbench::test::run ( thread_count const hardware )
+markbench::test_loops
+        markbench::function_loops ( test_function const &function )
+{
+    static test_function const nothing = [] ( ) {};
+    return {
+            [ function ] ( loop_state &state ) {
+                run_kernel< 1 > ( state, function );
+            },
+            [] ( loop_state &state ) { run_kernel< 1 > ( state, nothing ); },
+    };
+}
+
+markbench::test_result markbench::test::run ( thread_count const hardware,
+                                              run_options const &options )
 {
+    auto const &length    = options.length;
+    auto const &placement = options.placement;
+    // picks the clock before any thread reads it.
+    timing::calibrated ( );
+
     test_running.store ( true );
     std::vector< std::jthread > threads;
-    std::vector< counter_type > counters;
-    std::atomic_bool            test = false;
+    markbench::counter_bank     counters { hardware };
+    // 0 before the test starts, then the current measurement window.
+    std::atomic_uintmax_t       epoch = 0;
     test_latch                  arrive { hardware };
-    test_latch                  exit { hardware };
-    test_counters               result;
+    test_result                 result { };
+    // each thread's performance counters.
+    std::vector< perf::readings > events ( hardware );
+    // each thread's latency histogram, each in its own cache lines.
+    std::vector< std::unique_ptr< latency::recorder > > latencies;
+
+    if ( options.latency )
+    {
+        auto const overhead = latency::timer_overhead ( );
+        for ( thread_count i = 0; i < hardware; i++ )
+        {
+            latencies.push_back (
+                    std::make_unique< latency::recorder > ( overhead ) );
+        }
+    }
+
+    if ( !placement.empty ( ) )
+    {
+        result.placement.assign ( hardware, -1 );
+    }
 
     auto run_single = [ & ] ( thread_count id ) {
-        arrive.arrive ( );
-        while ( !test.load ( ) ) { }
-        while ( test.load ( ) )
+        markbench::local_counter counter { counters [ id ] };
+        if ( !placement.empty ( ) )
         {
-            test_fn ( );
-            counters.at ( id )->fetch_add ( 1 );
+            unsigned const cpu = placement.at ( id % placement.size ( ) );
+            if ( markbench::topology::pin_current_thread ( cpu ) )
+            {
+                result.placement [ id ] = cpu;
+            }
         }
-        exit.arrive ( );
+        std::unique_ptr< perf::thread_counters > performance;
+        if ( options.performance_counters )
+        {
+            performance = std::make_unique< perf::thread_counters > ( );
+        }
+
+        loop_state state { .counter = counter,
+                           .epoch   = epoch,
+                           .context = { id, hardware } };
+        state.begin = [ & ] ( ) {
+            arrive.arrive ( );
+            while ( ( state.seen = epoch.load ( ) ) == 0 ) { }
+            if ( performance )
+            {
+                performance->start ( );
+            }
+            counter.acknowledge ( state.seen );
+        };
+        state.end = [ & ] ( ) {
+            if ( performance )
+            {
+                performance->stop ( );
+                events [ id ]            = performance->read ( );
+                events [ id ].iterations = counter.value ( );
+            }
+            counter.flush ( );
+        };
+        if ( options.latency )
+        {
+            state.latencies = latencies [ id ].get ( );
+        }
+        loops.measured ( state );
     };
 
+    // every thread is joined before run returns, since each one's counter
+    // and performance counters flush into this frame as they are destroyed.
     auto add_thread = [ & ] ( thread_count id ) {
         threads.push_back ( std::jthread ( std::bind ( run_single, id ) ) );
-        counters.push_back ( std::unique_ptr< std::atomic_uintmax_t > (
-                new std::atomic_uintmax_t ( 0 ) ) );
     };
 
-    auto start_thread = [ & ] ( std::jthread &j ) { j.detach ( ); };
-
-    auto stop_thread = [ & ] ( std::jthread &j ) {
-        while ( j.joinable ( ) ) { j.join ( ); }
-    };
+    auto stop_thread = [ & ] ( std::jthread &j ) { j.join ( ); };
 
-    auto copy_result = [ & ] ( counter_type const &c ) {
-        result.push_back ( c->load ( ) );
-    };
     // std::cout << "here 1\n";
     for ( thread_count i = 0; i < hardware; i++ ) { add_thread ( i ); }
-    // std::cout << "here 2\n";
-    std::for_each ( threads.begin ( ), threads.end ( ), start_thread );
     // std::cout << "here 3\n";
     arrive.wait ( );
     // std::cout << "here 4\n";
-    test.store ( true );
+    epoch.store ( 1 );
     // std::cout << "here 5\n";
-    using namespace std::chrono_literals;
-    std::this_thread::sleep_for ( 1s );
+    using clock = std::chrono::steady_clock;
+    timing::ticks const            start        = timing::start ( );
+    timing::ticks                  window_start = start;
+    test_duration                  window       = length.window;
+    std::uintmax_t                 previous     = 0;
+    markbench::statistics::samples throughput;
+
+    // how long the test has run, and how much of that was untimed.
+    test_duration                                   wall { };
+    std::chrono::duration< long double, std::nano > previous_untimed { };
+
+    // keep taking windows until the confidence interval is narrow enough.
+    for ( std::uintmax_t current = 2;; current++ )
+    {
+        std::this_thread::sleep_for (
+                std::min ( window, length.maximum - wall ) );
+        epoch.store ( current );
+        // threads acknowledge between iterations, so timing the window from
+        // acknowledgement to acknowledgement means that slow tests are timed
+        // over whole iterations.
+        for ( auto spin = clock::now ( ); !counters.acknowledged ( current ); )
+        {
+            using namespace std::chrono_literals;
+            if ( clock::now ( ) - spin < 1ms )
+            {
+                std::this_thread::yield ( );
+            } else
+            {
+                std::this_thread::sleep_for ( 100us );
+            }
+        }
+        timing::ticks const window_end = timing::stop ( );
+
+        result.counters = counters.collect ( );
+        std::uintmax_t const total =
+                std::accumulate ( result.counters.begin ( ),
+                                  result.counters.end ( ),
+                                  std::uintmax_t { 0 } );
+        std::uintmax_t const iterations = total - previous;
+        // untimed work (fixture resets) comes out of the window, averaged
+        // over the threads since each thread did its own.
+        std::vector< std::uintmax_t > const excluded =
+                counters.collect_excluded ( );
+        std::chrono::duration< long double, std::nano > const untimed {
+                std::accumulate ( excluded.begin ( ),
+                                  excluded.end ( ),
+                                  std::uintmax_t { 0 } )
+                / ( long double ) hardware };
+        std::chrono::duration< long double > const seconds =
+                std::chrono::duration< long double, std::nano > (
+                        timing::nanoseconds ( window_end - window_start ) )
+                - ( untimed - previous_untimed );
+        if ( iterations >= length.minimum_iterations * hardware
+             && seconds.count ( ) > 0 )
+        {
+            throughput.push_back ( iterations / seconds.count ( ) );
+        } else
+        {
+            // too few iterations to say anything. Grow the window to fit
+            // enough iterations, going by the rate seen so far.
+            window = std::max (
+                    window * 2,
+                    std::chrono::duration_cast< test_duration > (
+                            seconds * ( length.minimum_iterations * hardware )
+                            / std::max ( iterations, std::uintmax_t { 1 } ) ) );
+        }
+        previous         = total;
+        previous_untimed = untimed;
+        window_start     = window_end;
+        wall             = timing::to_duration ( window_end - start );
+        result.elapsed =
+                wall - std::chrono::duration_cast< test_duration > ( untimed );
+        result.windows = throughput.size ( );
+
+        long double const mean = markbench::statistics::mean ( throughput );
+        result.relative_error =
+                mean > 0 ? markbench::statistics::confidence_half_width (
+                                   throughput )
+                                   / mean
+                         : std::numeric_limits< long double >::infinity ( );
+
+        if ( wall >= length.maximum )
+        {
+            break;
+        }
+        if ( wall >= length.minimum
+             && result.windows >= length.minimum_windows
+             && result.relative_error <= length.target_error )
+        {
+            break;
+        }
+    }
     // std::cout << "here 6\n";
-    test.store ( false );
-    exit.wait ( );
+    epoch.store ( stopped_epoch );
     // std::cout << "here 7\n";
     std::for_each ( threads.begin ( ), threads.end ( ), stop_thread );
     threads.clear ( );
+    if ( options.performance_counters )
+    {
+        result.events = events.front ( );
+        for ( std::size_t i = 1; i < events.size ( ); i++ )
+        {
+            result.events += events [ i ];
+        }
+    }
+    for ( auto const &recorder : latencies )
+    {
+        result.latencies += recorder->snapshot ( );
+    }
     // std::cout << "here 8\n";
-    std::for_each ( counters.begin ( ), counters.end ( ), copy_result );
-    // std::cout << "here 9\n";
     test_running.store ( false );
     // std::cout << "here A\n";
     return result;
-}
\ No newline at end of file
+}
+
+long double markbench::test::loop_overhead ( ) const
+{
+    using namespace std::chrono_literals;
+    test        empty { test_loops { loops.empty, loops.empty } };
+    run_options options { };
+    options.length.minimum = 100ms;
+    options.length.maximum = 1s;
+    options.length.window  = 20ms;
+
+    test_result const result = empty.run ( 1, options );
+    std::chrono::duration< long double, std::nano > const elapsed =
+            result.elapsed;
+    return result.counters.front ( )
+                 ? elapsed.count ( ) / result.counters.front ( )
+                 : 0;
+}
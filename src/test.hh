@@ -11,10 +11,18 @@
  */
 #pragma once
 
+#include "counters.hh"
+#include "latency.hh"
+#include "perf-counters.hh"
+#include "timing.hh"
+
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace markbench
@@ -29,18 +37,324 @@ namespace markbench
 
     using test_counters = std::vector< std::uintmax_t >;
 
+    using test_duration = std::chrono::steady_clock::duration;
+
+    /**
+     * @brief How long a test runs. Instead of a fixed window, the test keeps
+     * taking measurement windows until the 95% confidence interval on the
+     * throughput is within target_error of the mean, but never runs for less
+     * than minimum or more than maximum.
+     */
+    struct run_length
+    {
+        test_duration  minimum = std::chrono::milliseconds ( 250 );
+        test_duration  maximum = std::chrono::seconds ( 10 );
+        // the first window. A window where the threads averaged fewer than
+        // minimum_iterations does not count and the windows after it are
+        // made long enough to fit that many.
+        test_duration  window             = std::chrono::milliseconds ( 50 );
+        long double    target_error       = 0.02L;
+        std::size_t    minimum_windows    = 5;
+        std::uintmax_t minimum_iterations = 4;
+    };
+
+    struct test_result
+    {
+        // iterations per thread over the measured windows.
+        test_counters counters;
+        // the time the counters were measured over, less the average time
+        // each thread spent in untimed fixture resets.
+        test_duration elapsed;
+        std::size_t   windows;
+        // half-width of the 95% confidence interval on throughput, relative to
+        // the mean throughput.
+        long double   relative_error;
+        // the logical CPU each thread was pinned to, -1 if pinning failed.
+        // Empty if the threads were left to the scheduler.
+        std::vector< int >    placement;
+        // summed over every thread, from the start of the test to its end.
+        perf::readings        events;
+        // the time each iteration took, over every thread. Empty unless
+        // latencies were sampled.
+        latency::distribution latencies;
+        // nanoseconds per iteration that the empty loop took. 0 if unknown.
+        long double           loop_overhead = 0;
+    };
+
+    /**
+     * @brief Everything about how a single test run is measured.
+     */
+    struct run_options
+    {
+        run_length              length;
+        // the logical CPU to pin each thread to. Empty leaves the threads to
+        // the scheduler.
+        std::vector< unsigned > placement;
+        // whether to read the hardware performance counters.
+        bool                    performance_counters = false;
+        // whether to time every iteration. Costs two clock reads per
+        // iteration, which matters for the fastest tests.
+        bool                    latency              = false;
+    };
+
+    /**
+     * @brief One point of a thread-count sweep.
+     */
+    struct scaling_point
+    {
+        thread_count threads;
+        // rhedstones over all threads.
+        long double  throughput;
+        // throughput relative to the one-thread throughput.
+        long double  speedup;
+        // speedup per thread. 1 is perfect scaling.
+        long double  efficiency;
+    };
+
+    /**
+     * @brief The epoch that tells every thread to stop.
+     */
+    inline constexpr std::uintmax_t stopped_epoch = UINTMAX_MAX;
+
+    /**
+     * @brief Which thread a fixture is being set up for.
+     */
+    struct fixture_context
+    {
+        thread_count thread;
+        thread_count threads;
+    };
+
+    /**
+     * @brief Everything that a thread's measurement loop reads and writes.
+     */
+    struct loop_state
+    {
+        local_counter               &counter;
+        std::atomic_uintmax_t const &epoch;
+        fixture_context              context;
+        // waits for the test to start, then sets seen. Anything before it is
+        // untimed setup.
+        std::function< void ( ) >    begin { };
+        // called as soon as the thread stops. Anything after it is untimed
+        // teardown.
+        std::function< void ( ) >    end { };
+        // the last epoch this thread acknowledged.
+        std::uintmax_t               seen      = 0;
+        // null unless every iteration is timed.
+        latency::recorder           *latencies = nullptr;
+    };
+
+    /**
+     * @brief Runs the kernel batch times over, then counts all batch
+     * iterations and checks for a new window at once. The kernel is a template
+     * parameter so that it inlines into the loop.
+     */
+    template < std::size_t batch, typename kernel_type >
+    inline void measurement_loop ( loop_state &state, kernel_type const &kernel )
+    {
+        auto const unrolled = [ & ]< std::size_t... i > (
+                                      std::index_sequence< i... > ) {
+            ( ( ( void ) i, kernel ( ) ), ... );
+        };
+        while ( state.seen != stopped_epoch )
+        {
+            unrolled ( std::make_index_sequence< batch > { } );
+            state.counter.advance ( batch );
+            std::uintmax_t const now =
+                    state.epoch.load ( std::memory_order_relaxed );
+            if ( now != state.seen )
+            {
+                state.counter.acknowledge ( now );
+                state.seen = now;
+            }
+        }
+    }
+
+    /**
+     * @brief The reset of a kernel that needs none.
+     */
+    struct no_reset
+    {
+        inline void operator( ) ( ) const noexcept { }
+    };
+
+    /**
+     * @brief The whole measurement loop for a kernel. Timing every iteration
+     * means timing them one at a time, so batch only applies without it. If
+     * there is a reset, it runs before every iteration and the time it takes
+     * is taken back out of the thread's measured time, so batch does not apply
+     * either.
+     */
+    template < std::size_t batch,
+               typename kernel_type,
+               typename reset_type = no_reset >
+    void run_kernel ( loop_state        &state,
+                      kernel_type const &kernel,
+                      reset_type const  &reset = no_reset { } )
+    {
+        auto timed = [ & ] ( ) {
+            timing::ticks const start = timing::start ( );
+            kernel ( );
+            timing::ticks const stop = timing::stop ( );
+            state.latencies->record ( timing::to_duration ( stop - start ) );
+        };
+
+        state.begin ( );
+        if constexpr ( std::is_same_v< reset_type, no_reset > )
+        {
+            if ( state.latencies )
+            {
+                measurement_loop< 1 > ( state, timed );
+            } else
+            {
+                measurement_loop< batch > ( state, kernel );
+            }
+        } else
+        {
+            measurement_loop< 1 > ( state, [ & ] ( ) {
+                timing::ticks const start = timing::start ( );
+                reset ( );
+                timing::ticks const stop = timing::stop ( );
+                state.counter.exclude ( std::uintmax_t (
+                        timing::nanoseconds ( stop - start ) ) );
+                if ( state.latencies )
+                {
+                    timed ( );
+                } else
+                {
+                    kernel ( );
+                }
+            } );
+        }
+        state.end ( );
+    }
+
+    using loop_function = std::function< void ( loop_state & ) >;
+
+    /**
+     * @brief A test's measurement loop and the same loop with nothing in it,
+     * which tells us how much of each iteration is the loop itself.
+     */
+    struct test_loops
+    {
+        loop_function measured;
+        loop_function empty;
+    };
+
+    /**
+     * @brief The loops for a test that only has a test_function. Every
+     * iteration is an indirect call through the std::function.
+     */
+    test_loops function_loops ( test_function const &function );
+
+    /**
+     * @brief The loops for a kernel known at compile time. The loop is
+     * instantiated for the kernel, so the kernel inlines and batch iterations
+     * share each counter update.
+     */
+    template < auto kernel, std::size_t batch = 16 > test_loops batched_loops ( )
+    {
+        return {
+                [] ( loop_state &state ) {
+                    run_kernel< batch > ( state, [] ( ) { kernel ( ); } );
+                },
+                [] ( loop_state &state ) {
+                    run_kernel< batch > ( state, [] ( ) { } );
+                },
+        };
+    }
+
+    /**
+     * @brief A fixture is a class whose constructor is per-thread setup,
+     * whose call operator is the timed kernel, and whose destructor is
+     * teardown. Its constructor takes the test's own arguments, if it has any,
+     * then a fixture_context if it wants one. It may have a reset that runs,
+     * untimed, before every iteration.
+     *
+     * It may also have a finish that runs, untimed, once the thread has
+     * stopped, for work that can throw, such as checking a result. A
+     * destructor must not throw, so that work cannot wait for teardown.
+     */
+    template < typename fixture_type >
+    concept resettable = requires ( fixture_type &f ) { f.reset ( ); };
+
+    template < typename fixture_type >
+    concept finishable = requires ( fixture_type &f ) { f.finish ( ); };
+
+    template < typename fixture_type, typename... argument_types >
+    fixture_type make_fixture ( fixture_context const &context,
+                                argument_types const  &...arguments )
+    {
+        if constexpr ( std::is_constructible_v< fixture_type,
+                                                argument_types const &...,
+                                                fixture_context const & > )
+        {
+            return fixture_type { arguments..., context };
+        } else
+        {
+            return fixture_type { arguments... };
+        }
+    }
+
+    /**
+     * @brief The loops for a fixture, which every thread constructs from
+     * arguments. Setup, reset, finish and teardown are all left out of the
+     * measured time.
+     */
+    template < typename fixture_type,
+               std::size_t batch = 1,
+               typename... argument_types >
+    test_loops fixture_loops ( argument_types const &...arguments )
+    {
+        return {
+                [ arguments... ] ( loop_state &state ) {
+                    auto fixture = make_fixture< fixture_type > (
+                            state.context, arguments... );
+                    auto kernel = [ & ] ( ) { fixture ( ); };
+                    if constexpr ( resettable< fixture_type > )
+                    {
+                        run_kernel< batch > ( state, kernel, [ & ] ( ) {
+                            fixture.reset ( );
+                        } );
+                    } else
+                    {
+                        run_kernel< batch > ( state, kernel );
+                    }
+                    if constexpr ( finishable< fixture_type > )
+                    {
+                        fixture.finish ( );
+                    }
+                },
+                [] ( loop_state &state ) {
+                    run_kernel< batch > ( state, [] ( ) { } );
+                },
+        };
+    }
+
     class test
     {
-        test_function    test_fn      = [] ( ) {};
+        test_loops       loops;
         std::atomic_bool test_running = false;
     public:
-        test ( test_function const &function ) : test_fn { function } { }
+        test ( test_function const &function ) :
+                loops { function_loops ( function ) }
+        { }
+
+        test ( test_loops const &loops ) : loops { loops } { }
 
         ~test ( )
         {
             while ( test_running.load ( ) ) { }
         }
 
-        test_counters run ( thread_count const hardware = thread_count { 1 } );
+        test_result run ( thread_count const hardware = thread_count { 1 },
+                          run_options const &options  = run_options { } );
+
+        /**
+         * @brief Nanoseconds per iteration that the empty loop takes on one
+         * thread, i.e., what the harness adds to every iteration of this test.
+         */
+        long double loop_overhead ( ) const;
     };
 } // namespace markbench
\ No newline at end of file
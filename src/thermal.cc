@@ -0,0 +1,185 @@
+/**
+ * @file thermal.cc
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Reads the CPU clocks and thermal zones.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+
+#include "thermal.hh"
+
+#include "topology.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <string>
+
+namespace thermal = markbench::thermal;
+
+#if defined( LINUX )
+/**
+ * @brief The average of the "cpu MHz" lines of the given processors, for
+ * machines (mostly virtual ones) without cpufreq.
+ */
+static long double cpuinfo_megahertz ( std::vector< unsigned > const &cpus )
+{
+    std::ifstream file { "/proc/cpuinfo" };
+    std::string   line;
+    unsigned      processor = 0;
+    long double   total     = 0;
+    std::size_t   count     = 0;
+    while ( std::getline ( file, line ) )
+    {
+        auto const colon = line.find ( ':' );
+        if ( colon == std::string::npos )
+        {
+            continue;
+        }
+        if ( line.starts_with ( "processor" ) )
+        {
+            processor = std::stoul ( line.substr ( colon + 1 ) );
+        } else if ( line.starts_with ( "cpu MHz" )
+                    && std::find ( cpus.begin ( ), cpus.end ( ), processor )
+                               != cpus.end ( ) )
+        {
+            total += std::stold ( line.substr ( colon + 1 ) );
+            count++;
+        }
+    }
+    return count ? total / count : std::nanl ( "" );
+}
+#endif
+
+thermal::reading thermal::read ( std::vector< unsigned > const &cpus )
+{
+    reading result { std::nanl ( "" ), std::nanl ( "" ) };
+#if defined( LINUX )
+    std::vector< unsigned > watched = cpus;
+    if ( watched.empty ( ) )
+    {
+        for ( auto const &cpu : topology::logical_cpus ( ) )
+        {
+            watched.push_back ( cpu.id );
+        }
+    }
+
+    long double total = 0;
+    std::size_t count = 0;
+    for ( auto const cpu : watched )
+    {
+        std::ifstream file { "/sys/devices/system/cpu/cpu"
+                             + std::to_string ( cpu )
+                             + "/cpufreq/scaling_cur_freq" };
+        long double   kilohertz;
+        if ( file >> kilohertz )
+        {
+            total += kilohertz / 1000;
+            count++;
+        }
+    }
+    result.megahertz = count ? total / count : cpuinfo_megahertz ( watched );
+
+    // the zones are numbered from 0 without gaps.
+    for ( unsigned zone = 0;; zone++ )
+    {
+        std::ifstream file { "/sys/class/thermal/thermal_zone"
+                             + std::to_string ( zone ) + "/temp" };
+        if ( !file )
+        {
+            break;
+        }
+        long double millidegrees;
+        if ( file >> millidegrees )
+        {
+            result.celsius = std::fmax ( result.celsius, millidegrees / 1000 );
+        }
+    }
+#else
+    ( void ) cpus;
+#endif
+    return result;
+}
+
+long double thermal::base_megahertz ( )
+{
+#if defined( LINUX )
+    std::ifstream file {
+            "/sys/devices/system/cpu/cpu0/cpufreq/base_frequency" };
+    long double   kilohertz;
+    if ( file >> kilohertz )
+    {
+        return kilohertz / 1000;
+    }
+#endif
+    return std::nanl ( "" );
+}
+
+bool thermal::summary::has_clock ( ) const noexcept
+{
+    return !std::isnan ( mean_megahertz );
+}
+
+thermal::sampler::sampler ( std::vector< unsigned > const  &cpus,
+                            std::chrono::milliseconds const interval )
+    : cpus { cpus }, interval { interval }, worker { &sampler::sample, this }
+{ }
+
+thermal::sampler::~sampler ( )
+{
+    if ( worker.joinable ( ) )
+    {
+        stop ( );
+    }
+}
+
+void thermal::sampler::sample ( )
+{
+    std::unique_lock guard { lock };
+    while ( !stopping )
+    {
+        guard.unlock ( );
+        reading const r = read ( cpus );
+        guard.lock ( );
+        readings.push_back ( r );
+        wake.wait_for ( guard, interval, [ this ] { return stopping; } );
+    }
+}
+
+thermal::summary thermal::sampler::stop ( )
+{
+    {
+        std::scoped_lock guard { lock };
+        stopping = true;
+    }
+    wake.notify_all ( );
+    worker.join ( );
+    readings.push_back ( read ( cpus ) );
+
+    summary     result;
+    long double total  = 0;
+    std::size_t clocks = 0;
+    result.samples     = readings.size ( );
+    for ( auto const &r : readings )
+    {
+        if ( !std::isnan ( r.megahertz ) )
+        {
+            total += r.megahertz;
+            clocks++;
+            result.minimum_megahertz =
+                    std::fmin ( result.minimum_megahertz, r.megahertz );
+        }
+        // fmax ignores NaN unless both are.
+        result.maximum_celsius =
+                std::fmax ( result.maximum_celsius, r.celsius );
+    }
+    if ( clocks )
+    {
+        result.mean_megahertz = total / clocks;
+    }
+    return result;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file thermal.hh
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Watches the CPU clock and temperature while a test runs, to catch
+ * the machine throttling itself.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace markbench::thermal
+{
+    /**
+     * @brief One look at the machine. NaN where the operating system does not
+     * say.
+     */
+    struct reading
+    {
+        // the average current clock of the watched CPUs.
+        long double megahertz;
+        // the hottest thermal zone.
+        long double celsius;
+    };
+
+    /**
+     * @brief Reads the clocks of the given logical CPUs (every online one if
+     * empty) and the thermal zones. On Linux, the clocks come from cpufreq's
+     * scaling_cur_freq or, without cpufreq, from /proc/cpuinfo, and the
+     * temperatures from /sys/class/thermal. Everywhere else, all NaN.
+     */
+    reading read ( std::vector< unsigned > const &cpus );
+
+    /**
+     * @brief The clock the CPUs are rated to hold with every core busy, from
+     * cpufreq's base_frequency on Linux. NaN where it is not known.
+     */
+    long double base_megahertz ( );
+
+    /**
+     * @brief What a sampler saw. NaN where no sample had a value.
+     */
+    struct summary
+    {
+        static constexpr long double none =
+                std::numeric_limits< long double >::quiet_NaN ( );
+        std::size_t samples           = 0;
+        long double mean_megahertz    = none;
+        long double minimum_megahertz = none;
+        long double maximum_celsius   = none;
+
+        bool has_clock ( ) const noexcept;
+    };
+
+    /**
+     * @brief Reads the machine every interval on its own thread from
+     * construction until stop.
+     */
+    class sampler
+    {
+        std::vector< unsigned >   cpus;
+        std::chrono::milliseconds interval;
+        std::vector< reading >    readings;
+        std::mutex                lock;
+        std::condition_variable   wake;
+        bool                      stopping = false;
+        std::thread               worker;
+
+        void sample ( );
+    public:
+        explicit sampler ( std::vector< unsigned > const &cpus,
+                           std::chrono::milliseconds const interval =
+                                   std::chrono::milliseconds ( 100 ) );
+
+        sampler ( sampler const & )            = delete;
+        sampler &operator= ( sampler const & ) = delete;
+
+        ~sampler ( );
+
+        // takes one last reading so that even a short run has one.
+        summary stop ( );
+    };
+} // namespace markbench::thermal
@@ -0,0 +1,127 @@
+/**
+ * @file timing.cc
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Picks and calibrates the clock.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+
+#include "timing.hh"
+
+#if defined( MARKBENCH_HAS_TSC )
+#    include <cpuid.h>
+#endif
+
+#include <algorithm>
+#include <array>
+
+namespace timing = markbench::timing;
+
+static timing::source preferred = timing::source::tsc_rdtscp;
+
+std::string timing::source_name ( source const s )
+{
+    switch ( s )
+    {
+        case source::tsc_rdtscp: return "tsc (rdtscp)";
+        case source::tsc_lfence: return "tsc (lfence)";
+        case source::monotonic: return "monotonic";
+        default: return "?";
+    }
+}
+
+void timing::prefer ( source const s ) { preferred = s; }
+
+/**
+ * @brief Nanoseconds that NTP does not slew, to measure the counter against.
+ */
+static long double raw_now ( )
+{
+#if defined( LINUX )
+    timespec now;
+    clock_gettime ( CLOCK_MONOTONIC_RAW, &now );
+    return now.tv_sec * 1e9L + now.tv_nsec;
+#else
+    return std::chrono::duration< long double, std::nano > (
+                   std::chrono::steady_clock::now ( ).time_since_epoch ( ) )
+            .count ( );
+#endif
+}
+
+/**
+ * @brief The counter's rate: the median of a few 20ms spins, each bracketed
+ * by reads of both clocks.
+ */
+static long double measure_rate ( )
+{
+    std::array< long double, 5 > rates;
+    for ( auto &rate : rates )
+    {
+        long double const   since = raw_now ( );
+        timing::ticks const from  = timing::start ( );
+        long double         until;
+        while ( ( until = raw_now ( ) ) - since < 20e6L ) { }
+        timing::ticks const to = timing::stop ( );
+        rate                   = ( to - from ) / ( until - since );
+    }
+    std::sort ( rates.begin ( ), rates.end ( ) );
+    return rates [ rates.size ( ) / 2 ];
+}
+
+static timing::ticks measure_overhead ( )
+{
+    static constexpr std::size_t tries = 10000;
+
+    timing::ticks smallest = -1;
+    for ( std::size_t i = 0; i < tries; i++ )
+    {
+        timing::ticks const from = timing::start ( );
+        timing::ticks const to   = timing::stop ( );
+        smallest                 = std::min ( smallest, to - from );
+    }
+    return smallest;
+}
+
+static timing::calibration calibrate ( )
+{
+    timing::calibration result { timing::source::monotonic, false, 1, 0 };
+#if defined( MARKBENCH_HAS_TSC )
+    unsigned eax, ebx, ecx, edx;
+    unsigned highest = __get_cpuid_max ( 0x80000000, nullptr );
+    bool     rdtscp  = false;
+    if ( highest >= 0x80000001
+         && __get_cpuid ( 0x80000001, &eax, &ebx, &ecx, &edx ) )
+    {
+        rdtscp = edx & ( 1u << 27 );
+    }
+    if ( highest >= 0x80000007
+         && __get_cpuid ( 0x80000007, &eax, &ebx, &ecx, &edx ) )
+    {
+        result.invariant_tsc = edx & ( 1u << 8 );
+    }
+    if ( result.invariant_tsc && preferred != timing::source::monotonic )
+    {
+        result.kind = rdtscp && preferred == timing::source::tsc_rdtscp
+                            ? timing::source::tsc_rdtscp
+                            : timing::source::tsc_lfence;
+    }
+#endif
+    timing::detail::current = result.kind;
+    if ( result.kind != timing::source::monotonic )
+    {
+        result.ticks_per_nanosecond = measure_rate ( );
+    }
+    timing::detail::ticks_per_nanosecond = result.ticks_per_nanosecond;
+    result.overhead                      = measure_overhead ( );
+    return result;
+}
+
+timing::calibration const &timing::calibrated ( )
+{
+    static calibration const result = calibrate ( );
+    return result;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file timing.hh
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief The clock that measurements are read from: the time stamp counter
+ * where it runs at a constant rate, clock_gettime everywhere else.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+#    include <x86intrin.h>
+#    define MARKBENCH_HAS_TSC 1
+#endif
+
+#if defined( LINUX ) || defined( DARWIN )
+#    include <time.h>
+#endif
+
+namespace markbench::timing
+{
+    using ticks = std::uint64_t;
+
+    enum class source
+    {
+        // rdtsc fenced with lfence at the start and rdtscp at the stop.
+        tsc_rdtscp,
+        // rdtsc fenced with lfence on both sides, without rdtscp.
+        tsc_lfence,
+        // clock_gettime ( CLOCK_MONOTONIC ), or steady_clock without it.
+        monotonic,
+    };
+
+    std::string source_name ( source const s );
+
+    struct calibration
+    {
+        source      kind;
+        // whether cpuid says the counter ticks at the same rate in every
+        // P-state and C-state. The counter is only used if it does.
+        bool        invariant_tsc;
+        long double ticks_per_nanosecond;
+        // a start immediately followed by a stop, the least out of many
+        // tries. What every measurement pays for being measured.
+        ticks       overhead;
+    };
+
+    /**
+     * @brief Which source the next calibration picks, if the hardware
+     * allows. Only before the first call to calibrated.
+     */
+    void prefer ( source const s );
+
+    /**
+     * @brief The clock in use. The first call picks the source, measures the
+     * counter's rate against CLOCK_MONOTONIC_RAW, and measures the overhead,
+     * which takes about a tenth of a second. Until then, start and stop read
+     * the monotonic clock, so call this before timing anything.
+     */
+    calibration const &calibrated ( );
+
+    namespace detail
+    {
+        // set once by calibrated, before any test thread starts.
+        inline source      current              = source::monotonic;
+        inline long double ticks_per_nanosecond = 1;
+
+        inline ticks monotonic_now ( ) noexcept
+        {
+#if defined( LINUX ) || defined( DARWIN )
+            timespec now;
+            clock_gettime ( CLOCK_MONOTONIC, &now );
+            return ticks ( now.tv_sec ) * 1'000'000'000 + now.tv_nsec;
+#else
+            return std::chrono::duration_cast< std::chrono::nanoseconds > (
+                           std::chrono::steady_clock::now ( )
+                                   .time_since_epoch ( ) )
+                    .count ( );
+#endif
+        }
+    } // namespace detail
+
+    /**
+     * @brief Reads the clock once everything before it has finished, and
+     * before anything after it starts.
+     */
+    inline ticks start ( ) noexcept
+    {
+#if defined( MARKBENCH_HAS_TSC )
+        if ( detail::current != source::monotonic )
+        {
+            _mm_lfence ( );
+            ticks const now = __rdtsc ( );
+            _mm_lfence ( );
+            return now;
+        }
+#endif
+        return detail::monotonic_now ( );
+    }
+
+    /**
+     * @brief Reads the clock once everything before it has finished.
+     * rdtscp waits for earlier instructions by itself, and the lfence after
+     * it keeps later ones from starting early.
+     */
+    inline ticks stop ( ) noexcept
+    {
+#if defined( MARKBENCH_HAS_TSC )
+        if ( detail::current == source::tsc_rdtscp )
+        {
+            unsigned int cpu;
+            ticks const  now = __rdtscp ( &cpu );
+            _mm_lfence ( );
+            return now;
+        }
+        if ( detail::current == source::tsc_lfence )
+        {
+            return start ( );
+        }
+#endif
+        return detail::monotonic_now ( );
+    }
+
+    /**
+     * @brief Ticks as nanoseconds. The overhead is not taken out.
+     */
+    inline long double nanoseconds ( ticks const t ) noexcept
+    {
+        return t / detail::ticks_per_nanosecond;
+    }
+
+    inline std::chrono::nanoseconds to_duration ( ticks const t ) noexcept
+    {
+        return std::chrono::nanoseconds (
+                std::chrono::nanoseconds::rep ( nanoseconds ( t ) + 0.5L ) );
+    }
+} // namespace markbench::timing
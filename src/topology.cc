@@ -0,0 +1,272 @@
+/**
+ * @file topology.cc
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Reads the processor topology.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+
+#include "topology.hh"
+
+#if defined( LINUX )
+#    include <pthread.h>
+#    include <sched.h>
+#elif defined( WINDOWS )
+#    ifndef UNICODE
+#        define UNICODE 1
+#    endif
+#    include "windows.h"
+#endif
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+namespace topology = markbench::topology;
+
+std::vector< unsigned > topology::parse_cpu_list ( std::string const &list )
+{
+    std::vector< unsigned > result;
+    std::stringstream       ranges { list };
+    std::string             range;
+    while ( std::getline ( ranges, range, ',' ) )
+    {
+        if ( range.empty ( ) || range == "\n" )
+        {
+            continue;
+        }
+        std::size_t const dash  = range.find ( '-' );
+        unsigned const    first = std::stoul ( range.substr ( 0, dash ) );
+        unsigned const    last  = dash == std::string::npos
+                                        ? first
+                                        : std::stoul ( range.substr ( dash + 1 ) );
+        for ( unsigned i = first; i <= last; i++ ) { result.push_back ( i ); }
+    }
+    return result;
+}
+
+/**
+ * @brief Reads a single number out of a sysfs file.
+ * @return false if the file is not there.
+ */
+static bool read_number ( std::string const &path, unsigned &value )
+{
+    std::ifstream file { path };
+    return static_cast< bool > ( file >> value );
+}
+
+/**
+ * @brief Reads a CPU list out of a sysfs file.
+ */
+static std::vector< unsigned > read_list ( std::string const &path )
+{
+    std::ifstream file { path };
+    std::string   list;
+    if ( std::getline ( file, list ) )
+    {
+        return topology::parse_cpu_list ( list );
+    }
+    return { };
+}
+
+static std::vector< topology::logical_cpu > read_logical_cpus ( )
+{
+    std::vector< topology::logical_cpu > result;
+#if defined( LINUX )
+    static constexpr char const *const root = "/sys/devices/system/cpu/";
+    static constexpr char const *const numa = "/sys/devices/system/node/";
+
+    std::map< unsigned, unsigned > nodes;
+    for ( auto const node : read_list ( std::string ( numa ) + "online" ) )
+    {
+        std::string const path = numa + ( "node" + std::to_string ( node ) );
+        for ( auto const cpu : read_list ( path + "/cpulist" ) )
+        {
+            nodes [ cpu ] = node;
+        }
+    }
+
+    for ( auto const id : read_list ( std::string ( root ) + "online" ) )
+    {
+        std::string const base =
+                root + ( "cpu" + std::to_string ( id ) ) + "/topology/";
+        topology::logical_cpu cpu { id, id, 0, 0, 0 };
+        read_number ( base + "core_id", cpu.core );
+        read_number ( base + "physical_package_id", cpu.package );
+        if ( nodes.contains ( id ) )
+        {
+            cpu.node = nodes.at ( id );
+        }
+        result.push_back ( cpu );
+    }
+#endif
+    if ( result.empty ( ) )
+    {
+        unsigned const count = std::max ( std::thread::hardware_concurrency ( ),
+                                          1U );
+        for ( unsigned i = 0; i < count; i++ )
+        {
+            result.push_back ( { i, i, 0, 0, 0 } );
+        }
+    }
+
+    // siblings are numbered in the order of their ids.
+    std::map< std::pair< unsigned, unsigned >, unsigned > siblings;
+    for ( auto &cpu : result )
+    {
+        cpu.sibling = siblings [ { cpu.package, cpu.core } ]++;
+    }
+    return result;
+}
+
+std::vector< topology::logical_cpu > const &topology::logical_cpus ( )
+{
+    static std::vector< logical_cpu > const cpus = read_logical_cpus ( );
+    return cpus;
+}
+
+std::size_t topology::physical_cores ( )
+{
+    std::set< std::pair< unsigned, unsigned > > cores;
+    for ( auto const &cpu : logical_cpus ( ) )
+    {
+        cores.insert ( { cpu.package, cpu.core } );
+    }
+    return cores.size ( );
+}
+
+static std::map< topology::placement_policy, std::string > const policy_names = {
+        { topology::placement_policy::none, "none" },
+        { topology::placement_policy::compact, "compact" },
+        { topology::placement_policy::scatter, "scatter" },
+        { topology::placement_policy::physical, "physical" },
+        { topology::placement_policy::smt_pairs, "smt-pairs" },
+};
+
+bool topology::policy_from_name ( std::string const &name,
+                                  placement_policy  &policy )
+{
+    for ( auto const &[ p, n ] : policy_names )
+    {
+        if ( n == name )
+        {
+            policy = p;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string topology::policy_name ( placement_policy const policy )
+{
+    return policy_names.at ( policy );
+}
+
+std::vector< unsigned > topology::place ( placement_policy const policy,
+                                          std::size_t const      threads )
+{
+    if ( policy == placement_policy::none )
+    {
+        return { };
+    }
+
+    using core_id                   = std::pair< unsigned, unsigned >;
+    std::vector< logical_cpu > cpus = logical_cpus ( );
+
+    // where each core falls within its package, so that packages can take
+    // turns when scattering.
+    std::map< core_id, unsigned >  ordinal;
+    std::map< unsigned, unsigned > cores_in_package;
+    std::map< core_id, unsigned >  sibling_count;
+    for ( auto const &cpu : cpus )
+    {
+        if ( !ordinal.contains ( { cpu.package, cpu.core } ) )
+        {
+            ordinal [ { cpu.package, cpu.core } ] =
+                    cores_in_package [ cpu.package ]++;
+        }
+        sibling_count [ { cpu.package, cpu.core } ]++;
+    }
+
+    auto drop = [ & ] ( auto predicate ) {
+        std::vector< logical_cpu > kept;
+        std::copy_if ( cpus.begin ( ),
+                       cpus.end ( ),
+                       std::back_inserter ( kept ),
+                       predicate );
+        // with nothing left (say, smt-pairs without SMT), stay compact.
+        if ( !kept.empty ( ) )
+        {
+            cpus = kept;
+        }
+    };
+    auto order = [ & ] ( auto key ) {
+        std::stable_sort ( cpus.begin ( ),
+                           cpus.end ( ),
+                           [ & ] ( auto const &a, auto const &b ) {
+                               return key ( a ) < key ( b );
+                           } );
+    };
+    auto compact = [ & ] ( logical_cpu const &c ) {
+        return std::tuple { c.node,
+                            c.package,
+                            ordinal.at ( { c.package, c.core } ),
+                            c.sibling };
+    };
+
+    switch ( policy )
+    {
+        case placement_policy::scatter:
+            order ( [ & ] ( logical_cpu const &c ) {
+                return std::tuple { c.sibling,
+                                    ordinal.at ( { c.package, c.core } ),
+                                    c.package };
+            } );
+            break;
+        case placement_policy::physical:
+            drop ( [] ( logical_cpu const &c ) { return c.sibling == 0; } );
+            order ( compact );
+            break;
+        case placement_policy::smt_pairs:
+            drop ( [ & ] ( logical_cpu const &c ) {
+                return c.sibling < 2
+                    && sibling_count.at ( { c.package, c.core } ) >= 2;
+            } );
+            order ( compact );
+            break;
+        default: order ( compact ); break;
+    }
+
+    std::vector< unsigned > result;
+    for ( std::size_t i = 0; i < threads; i++ )
+    {
+        result.push_back ( cpus [ i % cpus.size ( ) ].id );
+    }
+    return result;
+}
+
+bool topology::pin_current_thread ( unsigned const cpu )
+{
+#if defined( LINUX )
+    cpu_set_t set;
+    CPU_ZERO ( &set );
+    CPU_SET ( cpu, &set );
+    return pthread_setaffinity_np ( pthread_self ( ), sizeof ( set ), &set )
+        == 0;
+#elif defined( WINDOWS )
+    return cpu < 64
+        && SetThreadAffinityMask ( GetCurrentThread ( ),
+                                   DWORD_PTR ( 1 ) << cpu );
+#else
+    return false;
+#endif
+}
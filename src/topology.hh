@@ -0,0 +1,87 @@
+/**
+ * @file topology.hh
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief What the processor looks like: which logical CPUs share a core and
+ * which cores share a package.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace markbench::topology
+{
+    struct logical_cpu
+    {
+        // the number the operating system knows this CPU by.
+        unsigned id;
+        // the physical core, only unique within its package.
+        unsigned core;
+        unsigned package;
+        // the NUMA node. 0 without NUMA.
+        unsigned node;
+        // which SMT sibling of its core this is, 0 for the first.
+        unsigned sibling;
+    };
+
+    /**
+     * @brief Where the threads of a multi-threaded test go.
+     */
+    enum class placement_policy
+    {
+        // leave it to the scheduler.
+        none,
+        // fill a core's SMT siblings before moving on to the next core, and a
+        // NUMA node before moving on to the next node.
+        compact,
+        // one thread per core, spread across packages, before doubling up.
+        scatter,
+        // only ever the first SMT sibling of each core.
+        physical,
+        // only cores with SMT siblings, and always both siblings of a core.
+        smt_pairs,
+    };
+
+    /**
+     * @brief The policy with the given name (as printed by policy_name).
+     * @return false if there is no such policy.
+     */
+    bool policy_from_name ( std::string const &name, placement_policy &policy );
+
+    std::string policy_name ( placement_policy const policy );
+
+    /**
+     * @brief Every online logical CPU. On Linux, this comes from
+     * /sys/devices/system/cpu. Everywhere else (or if sysfs is not mounted)
+     * every logical CPU is assumed to be its own core.
+     */
+    std::vector< logical_cpu > const &logical_cpus ( );
+
+    std::size_t physical_cores ( );
+
+    /**
+     * @brief The logical CPU for each of the given number of threads. Empty for
+     * placement_policy::none. If the policy does not have enough CPUs for
+     * every thread, it wraps around.
+     */
+    std::vector< unsigned > place ( placement_policy const policy,
+                                    std::size_t const      threads );
+
+    /**
+     * @brief Pins the calling thread to one logical CPU.
+     * @return false if the operating system would not let us.
+     */
+    bool pin_current_thread ( unsigned const cpu );
+
+    /**
+     * @brief Parses the kernel's CPU list format, e.g., "0-3,8,10-11".
+     */
+    std::vector< unsigned > parse_cpu_list ( std::string const &list );
+} // namespace markbench::topology
@@ -0,0 +1,41 @@
+/**
+ * @file check.hh
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief What the unit tests share: a check that reports a failure and keeps
+ * going, and the exit status that tells make whether any failed.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+#pragma once
+
+#include <cstdlib>
+#include <iostream>
+
+namespace markbench::tests
+{
+    inline int failures = 0;
+
+    /**
+     * @brief Reports the check, by the line it was made on, if it failed.
+     */
+    inline void check ( bool const passed, char const *what, int const line )
+    {
+        if ( !passed )
+        {
+            std::cerr << "line " << line << ": failed " << what << "\n";
+            failures++;
+        }
+    }
+
+    inline int exit_status ( )
+    {
+        return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+} // namespace markbench::tests
+
+#define CHECK( condition )                                                     \
+    markbench::tests::check ( ( condition ), #condition, __LINE__ )
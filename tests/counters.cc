@@ -0,0 +1,59 @@
+/**
+ * @file counters.cc
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Checks that a window's collected counts stay put while the threads
+ * run on past it.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+#include "check.hh"
+#include "counters.hh"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+int main ( )
+{
+    using markbench::local_counter;
+
+    markbench::counter_bank bank { 1 };
+    std::atomic_bool        collected = false;
+    std::uintmax_t const    in_window = 3 * local_counter::batch + 5;
+    std::uintmax_t const    afterward = 10 * local_counter::batch;
+
+    std::thread worker { [ & ] ( ) {
+        local_counter counter { bank [ 0 ] };
+        counter.advance ( in_window );
+        counter.exclude ( 100 );
+        counter.acknowledge ( 2 );
+        // keeps iterating, and publishing, after the window closed.
+        counter.advance ( afterward );
+        counter.exclude ( 50 );
+        counter.flush ( );
+        while ( !collected.load ( ) ) { std::this_thread::yield ( ); }
+        counter.advance ( afterward );
+    } };
+
+    while ( !bank.acknowledged ( 2 ) ) { std::this_thread::yield ( ); }
+    std::vector< std::uintmax_t > const counts   = bank.collect ( );
+    std::vector< std::uintmax_t > const excluded = bank.collect_excluded ( );
+    CHECK ( counts.size ( ) == 1 && counts [ 0 ] == in_window );
+    CHECK ( excluded.size ( ) == 1 && excluded [ 0 ] == 100 );
+
+    collected.store ( true );
+    worker.join ( );
+
+    // the thread ran on and flushed, but never acknowledged another window.
+    CHECK ( bank.collect ( ) == counts );
+    CHECK ( bank.collect_excluded ( ) == excluded );
+    CHECK ( bank [ 0 ].published.load ( ) == in_window + 2 * afterward );
+    CHECK ( !bank.acknowledged ( 3 ) );
+
+    return markbench::tests::exit_status ( );
+}
@@ -0,0 +1,48 @@
+/**
+ * @file statistics.cc
+ * @author Joshua Buchanan (joshuarobertbuchanan@gmail.com)
+ * @brief Checks which trials the outlier rule throws out, below and at the
+ * five samples it needs.
+ * @version 1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (C) 2022. Intellectual property of the author(s) listed
+ * above.
+ *
+ */
+#include "check.hh"
+#include "statistics.hh"
+
+#include <algorithm>
+#include <vector>
+
+namespace stats = markbench::statistics;
+
+namespace
+{
+    bool none ( std::vector< bool > const &rejected )
+    {
+        return std::none_of ( rejected.begin ( ),
+                              rejected.end ( ),
+                              [] ( bool const r ) { return r; } );
+    }
+} // namespace
+
+int main ( )
+{
+    // with three trials the spread is the 1 between 100 and 101, so 110
+    // would be thrown out. Below five, nothing is.
+    CHECK ( none ( stats::outliers ( { } ) ) );
+    CHECK ( none ( stats::outliers ( { 100 } ) ) );
+    CHECK ( none ( stats::outliers ( { 100, 110 } ) ) );
+    CHECK ( none ( stats::outliers ( { 100, 101, 110 } ) ) );
+    CHECK ( none ( stats::outliers ( { 100, 101, 102, 150 } ) ) );
+    CHECK ( stats::outliers ( { 100, 101, 110 } ).size ( ) == 3 );
+
+    // from five on, a wild trial is thrown out and only that one.
+    CHECK ( stats::outliers ( { 100, 101, 102, 101, 150 } )
+            == std::vector< bool > ( { false, false, false, false, true } ) );
+    CHECK ( none ( stats::outliers ( { 100, 101, 102, 101, 103 } ) ) );
+
+    return markbench::tests::exit_status ( );
+}